@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <opencv2/core.hpp>
+
+namespace vv {
+
+/**
+ * @brief 장면 변화에 따른 적응형 프레임 건너뛰기
+ *
+ * 측정한 프레임마다 고정 크기 격자의 축소 휘도를 이전 측정 프레임과 비교하여,
+ * 장면이 안정적이면 측정 간격을 두 배씩 늘리고 (최대 maxInterval),
+ * 변화가 감지되면 바로 매 프레임 측정으로 돌아갑니다.
+ * 건너뛴 프레임은 디코딩 없이 grab 만 하고 이전 추정을 이어서 사용합니다.
+ */
+class AdaptiveSkipper {
+public:
+    /**
+     * @brief 생성자
+     * @param maxInterval 측정 간격 상한 (적어도 이 프레임 수마다 한 번은 측정, 1 이하이면 건너뛰지 않음)
+     * @param changeThreshold 장면 변화 판정 기준 (축소 휘도의 샘플당 평균 절대 차이)
+     */
+    explicit AdaptiveSkipper(int maxInterval = 0, double changeThreshold = 2.0);
+
+    /**
+     * @brief 다음 프레임을 디코딩하여 측정해야 하는지
+     * @return 측정해야 하면 true, 이전 추정을 이어서 사용해도 되면 false
+     */
+    bool shouldMeasure() const;
+
+    /**
+     * @brief 프레임을 건너뛰었음을 기록
+     */
+    void frameSkipped();
+
+    /**
+     * @brief 측정한 프레임으로 장면 변화를 판정하고 다음 측정 간격 갱신
+     * @param image 측정한 프레임 (CV_8UC1 휘도 또는 CV_8UC3/CV_8UC4 BGR)
+     * @return 이전 측정 프레임 대비 장면이 변했는지 (첫 프레임은 항상 true)
+     */
+    bool frameMeasured(const cv::Mat& image);
+
+    /**
+     * @brief 현재 측정 사이에 건너뛰는 프레임 수
+     */
+    int skipInterval() const { return m_interval; }
+
+private:
+    static constexpr int THUMB_COLS = 40;
+    static constexpr int THUMB_ROWS = 30;
+
+    int m_maxInterval;
+    double m_changeThreshold;
+    int m_interval = 0;               // 측정 사이에 건너뛸 프레임 수
+    int m_skipped = 0;                // 마지막 측정 이후 건너뛴 프레임 수
+    std::vector<uint8_t> m_thumb;     // 마지막 측정 프레임의 축소 휘도
+    std::vector<uint8_t> m_current;   // 현재 프레임의 축소 휘도
+};
+
+} // namespace vv
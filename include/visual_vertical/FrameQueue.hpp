@@ -0,0 +1,135 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include <opencv2/core.hpp>
+#include "visual_vertical/Types.hpp"
+
+namespace vv {
+
+/**
+ * @brief 디코딩 스레드와 처리 루프 사이의 고정 용량 프레임 링
+ *
+ * 생산자는 빈 슬롯에 직접 디코딩하고, 소비자는 슬롯의 Mat 을 자신의 Mat 과 교환하여 꺼내므로
+ * 프레임 데이터를 복사하지 않으며, 크기가 같으면 슬롯 버퍼는 처음 한 번만 할당됩니다.
+ * 기본 모드에서는 링이 가득 차면 생산자가 기다리므로 (역압) 파일 입력에서 프레임을 잃지 않습니다.
+ * 최신 프레임 모드에서는 생산자가 기다리지 않고 가장 오래된 프레임을 버리며,
+ * 소비자는 항상 가장 최근 프레임만 꺼내고 그보다 오래된 프레임은 버립니다 (실시간 카메라의 지연 최소화).
+ */
+class FrameQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 꺼낸 프레임의 부가 정보
+     */
+    struct FrameInfo {
+        PixelFormat format = PixelFormat::BGR;
+        Clock::time_point timestamp{};    // 생산자가 프레임을 채운 시각
+        int droppedBefore = 0;            // 이전에 꺼낸 프레임과 이 프레임 사이에 버려진 프레임 수
+    };
+
+    /**
+     * @brief 생성자
+     * @param depth 링 용량 (최소 1)
+     * @param latestOnly 최신 프레임 모드 (생산자는 기다리지 않고, 소비자는 가장 최근 프레임만 꺼냄)
+     */
+    explicit FrameQueue(size_t depth, bool latestOnly = false);
+
+    /**
+     * @brief 다음에 채울 슬롯 얻기 (링이 가득 차 있으면 빈 슬롯이 생길 때까지 대기, 최신 프레임 모드이면 가장 오래된 프레임을 버림)
+     * @return 채울 슬롯, 소비자가 shutdown 했으면 nullptr
+     */
+    cv::Mat* beginWrite();
+
+    /**
+     * @brief beginWrite 로 얻은 슬롯을 채웠음을 알림
+     * @param format 슬롯 프레임의 픽셀 형식
+     */
+    void commitWrite(PixelFormat format);
+
+    /**
+     * @brief 더 이상 프레임이 없음을 알림 (남은 프레임은 계속 꺼낼 수 있음)
+     */
+    void close();
+
+    /**
+     * @brief 소비를 중단하고 기다리는 생산자를 깨움
+     */
+    void shutdown();
+
+    /**
+     * @brief 디코딩된 프레임 꺼내기 (비어 있으면 대기, 최신 프레임 모드이면 가장 최근 프레임을 꺼내고 나머지는 버림)
+     *
+     * 꺼낸 프레임과 frame 의 이전 버퍼를 교환하므로, 이전에 꺼낸 프레임 데이터는 다시 디코딩에 사용됩니다.
+     * @param[in,out] frame 꺼낸 프레임
+     * @param[out] info 꺼낸 프레임의 픽셀 형식, 시각, 직전에 버려진 프레임 수
+     * @return 프레임을 꺼냈으면 true, 닫힌 뒤 모두 꺼냈으면 false
+     */
+    bool pop(cv::Mat& frame, FrameInfo& info);
+
+    /**
+     * @brief 링 용량
+     */
+    size_t depth() const { return m_slots.size(); }
+
+    /**
+     * @brief 현재 대기 중인 프레임 수
+     */
+    size_t size() const;
+
+    /**
+     * @brief pop 시점에 대기 중이던 프레임 수의 평균 (링 점유율 확인용)
+     */
+    double meanOccupancy() const;
+
+    /**
+     * @brief 최신 프레임 모드에서 꺼내지 않고 버린 프레임 수
+     */
+    long long droppedFrames() const;
+
+    /**
+     * @brief 최신 프레임 모드인지
+     */
+    bool latestOnly() const { return m_latestOnly; }
+
+    /**
+     * @brief 링이 가득 차서 생산자가 기다린 횟수 (처리가 병목)
+     */
+    long long producerStalls() const;
+
+    /**
+     * @brief 링이 비어서 소비자가 기다린 횟수 (디코딩이 병목)
+     */
+    long long consumerStalls() const;
+
+private:
+    struct Slot {
+        cv::Mat frame;
+        PixelFormat format = PixelFormat::BGR;
+        Clock::time_point timestamp{};
+    };
+
+    std::vector<Slot> m_slots;
+    bool m_latestOnly;
+    size_t m_head = 0;                 // 다음에 꺼낼 슬롯
+    size_t m_count = 0;                // 대기 중인 프레임 수
+    bool m_closed = false;
+    bool m_shutdown = false;
+
+    long long m_pops = 0;
+    long long m_occupancySum = 0;
+    long long m_dropped = 0;           // 버린 프레임 수 (전체)
+    int m_droppedPending = 0;          // 마지막 pop 이후 버린 프레임 수
+    long long m_producerStalls = 0;
+    long long m_consumerStalls = 0;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+};
+
+} // namespace vv
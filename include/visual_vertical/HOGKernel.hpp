@@ -0,0 +1,589 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <cfloat>
+#include <vector>
+
+namespace vv {
+namespace kernel {
+
+/**
+ * @brief HOG 행(row) 단위 커널 모음
+ *
+ * ImageProcessor::computeHOG 의 그래디언트 → 임계값 → 침식 → 히스토그램 단계를
+ * 프레임 전체 float 중간 버퍼 없이 몇 개의 행 버퍼만으로 처리하기 위한 함수들입니다.
+ * OpenCV 에 의존하지 않으며 모든 입출력은 행 포인터로 주고받습니다.
+ * 이웃 픽셀을 읽는 커널은 영상 경계 처리를 위해 전체 열 개수와 계산할 열 범위 [xBegin, xEnd) 를 따로 받고,
+ * 픽셀 단위 커널은 호출하는 쪽에서 행 포인터를 범위 시작으로 옮겨 전달합니다.
+ */
+
+// cv::fastAtan2 와 동일한 다항식 계수 (도 단위)
+constexpr float ATAN2_P1 = 0.9997878412794807f * 57.29577951308232f;
+constexpr float ATAN2_P3 = -0.3258083974640975f * 57.29577951308232f;
+constexpr float ATAN2_P5 = 0.1555786518463281f * 57.29577951308232f;
+constexpr float ATAN2_P7 = -0.04432655554792128f * 57.29577951308232f;
+
+/**
+ * @brief cv::fastAtan2 와 같은 근사식으로 각도 계산
+ * @param y y 성분
+ * @param x x 성분
+ * @return 0 ~ 360 범위의 각도 (도)
+ */
+inline float fastAtanDegrees(float y, float x) {
+    float ax = std::abs(x);
+    float ay = std::abs(y);
+    // 작은 쪽 / 큰 쪽 비율로 팔분면 각도를 구한 뒤 되돌림
+    // (분기 없이 벡터화되도록 상수만 조건부로 고르고 base + sign * a 로 계산, sign 곱은 정확하므로 결과는 같음)
+    float c = std::min(ax, ay) / (std::max(ax, ay) + static_cast<float>(DBL_EPSILON));
+    float c2 = c * c;
+    float a = (((ATAN2_P7 * c2 + ATAN2_P5) * c2 + ATAN2_P3) * c2 + ATAN2_P1) * c;
+    a = ((ax >= ay) ? 0.f : 90.f) + ((ax >= ay) ? 1.f : -1.f) * a;
+    a = ((x < 0) ? 180.f : 0.f) + ((x < 0) ? -1.f : 1.f) * a;
+    a = ((y < 0) ? 360.f : 0.f) + ((y < 0) ? -1.f : 1.f) * a;
+    return a;
+}
+
+/**
+ * @brief 그래디언트 방향을 정수 빈 인덱스로 변환
+ *
+ * 기존 구현과 같이 각도가 180도 이상이면 180을 빼고 정수부를 취합니다.
+ * (360도로 반올림된 각도는 180번 빈이 되어 히스토그램에서 제외됩니다.)
+ *
+ * @param gx x 방향 그래디언트
+ * @param gy y 방향 그래디언트 (위쪽이 양수)
+ * @return 0 ~ 180 범위의 빈 인덱스
+ */
+inline int orientationBin(int gx, int gy) {
+    float deg = fastAtanDegrees(static_cast<float>(gy), static_cast<float>(gx));
+    deg += (deg >= 180.f) ? -180.f : 0.f;
+    return static_cast<int>(deg);
+}
+
+/**
+ * @brief 정수 연산만으로 그래디언트 방향을 1도 빈 인덱스로 변환
+ *
+ * 벡터를 위쪽 반평면으로 접은 뒤, 각 빈 경계 방향의 고정소수점 단위 벡터와의
+ * 외적 부호로 이진 탐색합니다. 경계 벡터의 양자화 오차(약 0.004도) 이내에서 floor(각도)와 같습니다.
+ *
+ * @param gx x 방향 그래디언트
+ * @param gy y 방향 그래디언트 (위쪽이 양수)
+ * @return 0 ~ 179 범위의 빈 인덱스
+ */
+int orientationBinInt(int gx, int gy);
+
+// 8비트 영상 3x3 Sobel 그래디언트 성분의 최대 절대값
+constexpr int MAX_SOBEL_GRADIENT = 4 * 255;
+
+/**
+ * @brief 기울기 비율 LUT 로 그래디언트 방향을 1도 빈 인덱스로 변환
+ *
+ * |gx|, |gy| 를 첫 팔분면으로 접어 min/max 비율을 역수 테이블 곱셈으로 4096 단계로 양자화하고,
+ * 비율별 각도 테이블(1/256도 단위)을 찾은 뒤 팔분면을 되돌립니다. 오차는 약 0.015도 이내입니다.
+ *
+ * @param gx x 방향 그래디언트 (|gx| <= MAX_SOBEL_GRADIENT)
+ * @param gy y 방향 그래디언트 (위쪽이 양수, |gy| <= MAX_SOBEL_GRADIENT)
+ * @return 0 ~ 179 범위의 빈 인덱스
+ */
+int orientationBinLut(int gx, int gy);
+
+/**
+ * @brief BORDER_REFLECT_101 규칙으로 경계 밖 인덱스를 안쪽으로 접기
+ * @param i 인덱스
+ * @param n 길이
+ * @return 0 ~ n-1 범위의 인덱스
+ */
+inline int reflect101(int i, int n) {
+    if (n == 1) {
+        return 0;
+    }
+    while (i < 0 || i >= n) {
+        i = (i < 0) ? -i : 2 * n - 2 - i;
+    }
+    return i;
+}
+
+/**
+ * @brief BGR(A) 한 행을 그레이스케일로 변환 (cv::COLOR_BGR2GRAY 와 같은 14비트 고정소수점 계수)
+ * @param src BGR 또는 BGRA 행
+ * @param cols 열 개수
+ * @param channels 채널 수 (3 또는 4)
+ * @param[out] dst 그레이 행
+ */
+void bgrToGrayRow(const uint8_t* src, int cols, int channels, uint8_t* dst);
+
+/**
+ * @brief 8비트 소수부 고정소수점 가우시안 커널 생성
+ *
+ * cv::GaussianBlur 의 8비트 비트 정확(bit-exact) 경로와 같이 오차 확산 방식으로 반올림하여
+ * 계수 합이 정확히 256이 되도록 합니다.
+ *
+ * @param ksize 커널 크기 (홀수)
+ * @param sigma 표준편차 (0 이하이면 ksize 로부터 계산)
+ * @return 고정소수점 계수
+ */
+std::vector<uint16_t> gaussianKernelFixedPoint(int ksize, double sigma);
+
+/**
+ * @brief 가로 방향 가우시안 블러 한 행 (BORDER_REFLECT_101)
+ * @param src 그레이 행 ([xBegin - ksize/2, xEnd + ksize/2) 범위가 유효해야 함)
+ * @param cols 열 개수
+ * @param xBegin 계산할 첫 열
+ * @param xEnd 계산할 마지막 열 다음
+ * @param taps 고정소수점 계수
+ * @param ksize 커널 크기
+ * @param[out] dst 8비트 소수부 고정소수점 결과
+ */
+void blurRowH(const uint8_t* src, int cols, int xBegin, int xEnd, const uint16_t* taps, int ksize, uint16_t* dst);
+
+/**
+ * @brief 세로 방향 가우시안 블러 한 행
+ * @param rows 세로 창에 포함된 가로 블러 결과 행 포인터 (ksize 개, 경계 접기 적용됨)
+ * @param cols 열 개수
+ * @param taps 고정소수점 계수
+ * @param ksize 커널 크기
+ * @param[out] dst 블러된 8비트 행
+ */
+void blurRowV(const uint16_t* const* rows, int cols, const uint16_t* taps, int ksize, uint8_t* dst);
+
+/**
+ * @brief 가우시안을 근사하는 반복 상자 필터의 반지름 계산
+ *
+ * 폭이 다른 홀수 상자 필터를 passes 번 적용했을 때 분산이 sigma^2 에 가장 가깝도록 폭을 고릅니다.
+ * 상자 필터는 이동 합으로 계산하므로 픽셀당 비용이 커널 크기와 무관합니다.
+ *
+ * @param ksize 가우시안 커널 크기 (sigma 가 0 이하일 때 sigma 계산용)
+ * @param sigma 표준편차 (0 이하이면 ksize 로부터 계산)
+ * @param passes 상자 필터 적용 횟수
+ * @return 단계별 상자 반지름 (폭 = 2 * 반지름 + 1)
+ */
+std::vector<int> boxBlurRadii(int ksize, double sigma, int passes);
+
+/**
+ * @brief 가로 방향 상자 필터 한 행 (이동 합, BORDER_REFLECT_101)
+ * @param src 그레이 행 ([xBegin - radius, xEnd + radius) 범위가 유효해야 함)
+ * @param cols 열 개수
+ * @param xBegin 계산할 첫 열
+ * @param xEnd 계산할 마지막 열 다음
+ * @param radius 상자 반지름
+ * @param[out] dst 8비트 소수부 고정소수점 평균 (blurRowH 와 같은 배율)
+ */
+void boxRowH(const uint8_t* src, int cols, int xBegin, int xEnd, int radius, uint16_t* dst);
+
+/**
+ * @brief 가로 방향 상자 필터 한 행 (8비트 소수부 고정소수점 입력)
+ */
+void boxRowH(const uint16_t* src, int cols, int xBegin, int xEnd, int radius, uint16_t* dst);
+
+/**
+ * @brief 세로 이동 합에 한 행을 더함
+ * @param src 8비트 소수부 고정소수점 행
+ * @param cols 열 개수
+ * @param[in,out] acc 열별 이동 합
+ */
+void boxAddRow(const uint16_t* src, int cols, uint32_t* acc);
+
+/**
+ * @brief 세로 이동 합에서 한 행을 뺌
+ * @param src 8비트 소수부 고정소수점 행
+ * @param cols 열 개수
+ * @param[in,out] acc 열별 이동 합
+ */
+void boxSubRow(const uint16_t* src, int cols, uint32_t* acc);
+
+/**
+ * @brief 세로 이동 합을 상자 폭으로 나누어 평균 행 계산
+ * @param acc 열별 이동 합
+ * @param cols 열 개수
+ * @param radius 상자 반지름
+ * @param[out] dst 8비트 소수부 고정소수점 평균
+ */
+void boxAverageRow(const uint32_t* acc, int cols, int radius, uint16_t* dst);
+
+/**
+ * @brief 세로 이동 합을 상자 폭으로 나누고 반올림하여 8비트 행 계산
+ * @param acc 열별 이동 합
+ * @param cols 열 개수
+ * @param radius 상자 반지름
+ * @param[out] dst 블러된 8비트 행
+ */
+void boxAverageRow8(const uint32_t* acc, int cols, int radius, uint8_t* dst);
+
+/**
+ * @brief 3x3 Sobel 그래디언트 한 행 계산 (BORDER_REFLECT_101)
+ * @param up 위쪽 행
+ * @param cur 현재 행
+ * @param down 아래쪽 행
+ * @param cols 열 개수
+ * @param xBegin 계산할 첫 열
+ * @param xEnd 계산할 마지막 열 다음
+ * @param[out] gx x 방향 그래디언트
+ * @param[out] gy y 방향 그래디언트 (부호 반전, 위쪽이 양수)
+ */
+void sobelRow(const uint8_t* up, const uint8_t* cur, const uint8_t* down, int cols, int xBegin, int xEnd,
+              int16_t* gx, int16_t* gy);
+
+/**
+ * @brief 가우시안 블러와 3x3 Sobel 을 합성한 1차원 계수 계산 (격자 샘플링용)
+ * @param taps 고정소수점 가우시안 계수 (합 256)
+ * @param ksize 가우시안 커널 크기
+ * @param[out] smooth 가우시안 * [1, 2, 1] 계수 (ksize + 2 개)
+ * @param[out] deriv 가우시안 * [-1, 0, 1] 계수 (ksize + 2 개)
+ */
+void sobelGaussianTaps(const uint16_t* taps, int ksize, int32_t* smooth, int32_t* deriv);
+
+/**
+ * @brief 합성 계수로 세로 방향 평활/미분 한 행 계산
+ * @param rows 세로 창에 포함된 그레이 행 포인터 (ksize 개, 경계 접기 적용됨)
+ * @param xBegin 계산할 첫 열
+ * @param xEnd 계산할 마지막 열 다음
+ * @param smooth 평활 계수
+ * @param deriv 미분 계수
+ * @param ksize 합성 계수 개수
+ * @param[out] outSmooth 세로 평활 결과
+ * @param[out] outDeriv 세로 미분 결과 (아래 - 위)
+ */
+void verticalDerivativeRow(const uint8_t* const* rows, int xBegin, int xEnd,
+                           const int32_t* smooth, const int32_t* deriv, int ksize,
+                           int32_t* outSmooth, int32_t* outDeriv);
+
+/**
+ * @brief 세로 방향 결과에 가로 방향 합성 계수를 적용해 격자점의 그래디언트 계산 (BORDER_REFLECT_101)
+ *
+ * 블러 후 Sobel 을 적용한 것과 같은 배율(8비트 영상 기준 |g| <= MAX_SOBEL_GRADIENT)로 반올림합니다.
+ *
+ * @param vSmooth 세로 평활 결과
+ * @param vDeriv 세로 미분 결과
+ * @param cols 열 개수
+ * @param stride 격자 간격 (격자 열 lx 는 픽셀 열 lx * stride)
+ * @param lxBegin 계산할 첫 격자 열
+ * @param lxEnd 계산할 마지막 격자 열 다음
+ * @param smooth 평활 계수
+ * @param deriv 미분 계수
+ * @param ksize 합성 계수 개수
+ * @param[out] gx 격자 열 단위 x 방향 그래디언트
+ * @param[out] gy 격자 열 단위 y 방향 그래디언트 (위쪽이 양수)
+ */
+void latticeGradientRow(const int32_t* vSmooth, const int32_t* vDeriv, int cols, int stride,
+                        int lxBegin, int lxEnd, const int32_t* smooth, const int32_t* deriv, int ksize,
+                        int16_t* gx, int16_t* gy);
+
+/**
+ * @brief 그래디언트 크기 제곱의 최소/최대값 갱신
+ * @param gx x 방향 그래디언트
+ * @param gy y 방향 그래디언트
+ * @param cols 열 개수
+ * @param[in,out] minSq 최소값
+ * @param[in,out] maxSq 최대값
+ */
+void magnitudeRange(const int16_t* gx, const int16_t* gy, int cols, int32_t& minSq, int32_t& maxSq);
+
+/**
+ * @brief 선택된 픽셀만으로 그래디언트 크기 제곱의 최소/최대값 갱신
+ * @param gx x 방향 그래디언트
+ * @param gy y 방향 그래디언트
+ * @param select 선택 여부 (0/1)
+ * @param cols 열 개수
+ * @param[in,out] minSq 최소값
+ * @param[in,out] maxSq 최대값
+ */
+void magnitudeRangeMasked(const int16_t* gx, const int16_t* gy, const uint8_t* select, int cols,
+                          int32_t& minSq, int32_t& maxSq);
+
+/**
+ * @brief 정규화된 그래디언트 크기에 임계값을 적용하고 방향 빈 계산
+ * @param gx x 방향 그래디언트
+ * @param gy y 방향 그래디언트
+ * @param cols 열 개수
+ * @param magMin 프레임 최소 그래디언트 크기
+ * @param invRange 1 / (최대 - 최소)
+ * @param threshold 정규화 크기 임계값 (초과하는 픽셀만 통과)
+ * @param[out] mask 임계값 통과 여부 (0/1)
+ * @param[out] bins 방향 빈 인덱스 (통과한 픽셀만 유효)
+ */
+void thresholdRow(const int16_t* gx, const int16_t* gy, int cols,
+                  float magMin, float invRange, float threshold,
+                  uint8_t* mask, uint8_t* bins);
+
+/**
+ * @brief 그래디언트 크기 제곱에 정수 임계값을 적용하고 방향 빈 계산 (정수 경로)
+ * @param gx x 방향 그래디언트
+ * @param gy y 방향 그래디언트
+ * @param cols 열 개수
+ * @param thresholdSq 크기 제곱 임계값 (초과하는 픽셀만 통과)
+ * @param[out] mask 임계값 통과 여부 (0/1)
+ * @param[out] bins 방향 빈 인덱스 (통과한 픽셀만 유효)
+ */
+void thresholdRowInt(const int16_t* gx, const int16_t* gy, int cols, int32_t thresholdSq,
+                     uint8_t* mask, uint8_t* bins);
+
+/**
+ * @brief 그래디언트 크기 제곱에 정수 임계값을 적용하고 LUT 로 방향 빈 계산
+ * @param gx x 방향 그래디언트
+ * @param gy y 방향 그래디언트
+ * @param cols 열 개수
+ * @param thresholdSq 크기 제곱 임계값 (초과하는 픽셀만 통과)
+ * @param[out] mask 임계값 통과 여부 (0/1)
+ * @param[out] bins 방향 빈 인덱스 (통과한 픽셀만 유효)
+ */
+void thresholdRowLut(const int16_t* gx, const int16_t* gy, int cols, int32_t thresholdSq,
+                     uint8_t* mask, uint8_t* bins);
+
+/**
+ * @brief 사각형 구조 요소로 한 행 침식
+ *
+ * 영상 밖 영역은 침식에 영향을 주지 않도록 (cv::erode 기본 경계와 동일) 창을 잘라서 사용합니다.
+ *
+ * @param rows 세로 창에 포함된 마스크 행 포인터 배열 (이미 영상 경계로 잘린 상태)
+ * @param rowCount 행 개수
+ * @param cols 열 개수
+ * @param xBegin 계산할 첫 열
+ * @param xEnd 계산할 마지막 열 다음
+ * @param ksize 구조 요소 크기
+ * @param[out] tmp 세로 AND 결과를 위한 임시 행
+ * @param[out] out 침식된 마스크 행
+ */
+void erodeRow(const uint8_t* const* rows, int rowCount, int cols, int xBegin, int xEnd, int ksize,
+              uint8_t* tmp, uint8_t* out);
+
+// 비트 마스크 워드 하나가 담는 픽셀 수
+constexpr int MASK_WORD_BITS = 64;
+
+// 히스토그램 누적 시 번갈아 사용하는 부분 히스토그램 개수
+constexpr int HIST_LANES = 4;
+
+/**
+ * @brief 비트 마스크 한 행의 워드 개수
+ * @param cols 열 개수
+ * @return 워드 개수
+ */
+inline int maskWords(int cols) {
+    return (cols + MASK_WORD_BITS - 1) / MASK_WORD_BITS;
+}
+
+/**
+ * @brief 0/1 마스크 행의 [xBegin, xEnd) 를 비트로 묶음 (픽셀 x 는 워드 x / 64 의 x % 64 번 비트)
+ *
+ * 범위를 포함하는 워드만 씁니다. 범위 밖 비트는 0 이고, 영상 밖 (x >= cols) 비트는
+ * 침식에 영향을 주지 않도록 1 로 채웁니다.
+ *
+ * @param mask 0/1 마스크 행
+ * @param cols 열 개수
+ * @param xBegin 묶을 첫 열
+ * @param xEnd 묶을 마지막 열 다음
+ * @param[out] bits 비트 마스크 행
+ */
+void packMaskRow(const uint8_t* mask, int cols, int xBegin, int xEnd, uint64_t* bits);
+
+/**
+ * @brief 사각형 구조 요소로 비트 마스크 한 행 침식 (세로 AND 후 이동한 워드의 AND)
+ *
+ * erodeRow 와 같이 영상 밖 영역은 침식에 영향을 주지 않습니다.
+ * [xBegin, xEnd) 를 포함하는 워드만 쓰며, 그 워드 안의 범위 밖 비트는 정의되지 않습니다.
+ *
+ * @param rows 세로 창에 포함된 비트 마스크 행 포인터 배열 (이미 영상 경계로 잘린 상태)
+ * @param rowCount 행 개수
+ * @param cols 열 개수
+ * @param xBegin 계산할 첫 열
+ * @param xEnd 계산할 마지막 열 다음
+ * @param ksize 구조 요소 크기
+ * @param[out] tmp 세로 AND 결과를 위한 임시 행 (maskWords(cols) 개)
+ * @param[out] out 침식된 비트 마스크 행
+ */
+void erodeBitsRow(const uint64_t* const* rows, int rowCount, int cols, int xBegin, int xEnd, int ksize,
+                  uint64_t* tmp, uint64_t* out);
+
+/**
+ * @brief 침식된 비트 마스크의 [xBegin, xEnd) 에서 설정된 비트만 HIST_LANES 개 부분 히스토그램에 누적
+ *
+ * 빈 워드는 통째로 건너뜁니다. hist 형식은 accumulateRowLanes 와 같습니다 (열 x 는 x % HIST_LANES 번 묶음).
+ *
+ * @param bits 침식된 비트 마스크 행
+ * @param xBegin 누적할 첫 열
+ * @param xEnd 누적할 마지막 열 다음
+ * @param bins 방향 빈 인덱스 행 (열 0 기준)
+ * @param binCount 히스토그램 빈 개수
+ * @param[in,out] hist 부분 히스토그램 묶음
+ * @return 설정된 비트 수
+ */
+int accumulateBitsRow(const uint64_t* bits, int xBegin, int xEnd, const uint8_t* bins, int binCount, uint32_t* hist);
+
+/**
+ * @brief 침식된 마스크 행을 히스토그램에 누적
+ * @param mask 침식된 마스크 행
+ * @param bins 방향 빈 인덱스 행
+ * @param cols 열 개수
+ * @param binCount 히스토그램 빈 개수
+ * @param[in,out] hist 히스토그램
+ * @return 마스크가 설정된 픽셀 수
+ */
+int accumulateRow(const uint8_t* mask, const uint8_t* bins, int cols, int binCount, uint32_t* hist);
+
+/**
+ * @brief 침식된 마스크 행을 HIST_LANES 개 부분 히스토그램에 나누어 누적
+ *
+ * 이웃 열이 같은 빈에 몰릴 때 같은 카운터를 연달아 갱신하지 않도록 열마다 다른 부분 히스토그램을 씁니다.
+ * hist 는 (binCount + 1) 개씩 HIST_LANES 묶음이며, 각 묶음의 마지막 칸은 범위 밖 빈을 버리는 자리입니다.
+ * 누적이 끝나면 foldHistLanes 로 첫 묶음에 합칩니다.
+ *
+ * @param mask 침식된 마스크 행
+ * @param bins 방향 빈 인덱스 행
+ * @param cols 열 개수
+ * @param binCount 히스토그램 빈 개수
+ * @param[in,out] hist 부분 히스토그램 묶음
+ * @return 마스크가 설정된 픽셀 수
+ */
+int accumulateRowLanes(const uint8_t* mask, const uint8_t* bins, int cols, int binCount, uint32_t* hist);
+
+/**
+ * @brief 침식된 비트 마스크의 [xBegin, xEnd) 에서 설정된 비트를 거친 히스토그램에 누적하고 빈 값을 모음
+ *
+ * 2단계 히스토그램의 첫 단계입니다. 투표마다 거친 빈 coarseOf[bin] 을 HIST_LANES 개 부분 히스토그램
+ * (coarseCount + 1 칸씩) 에 누적하고, 원래 빈 값을 votes 에 차례로 기록해 피크 주변 세밀 집계에 다시 씁니다.
+ *
+ * @param bits 침식된 비트 마스크 행
+ * @param xBegin 누적할 첫 열
+ * @param xEnd 누적할 마지막 열 다음
+ * @param bins 방향 빈 인덱스 행 (열 0 기준)
+ * @param coarseOf 빈 값 (0 ~ 255) 별 거친 빈 인덱스 (범위 밖 빈은 coarseCount)
+ * @param coarseCount 거친 빈 개수
+ * @param[in,out] coarseHist 거친 부분 히스토그램 묶음
+ * @param[out] votes 설정된 비트의 빈 값 (설정된 비트 수만큼 기록)
+ * @return 설정된 비트 수
+ */
+int collectBitsRow(const uint64_t* bits, int xBegin, int xEnd, const uint8_t* bins, const uint8_t* coarseOf,
+                   int coarseCount, uint32_t* coarseHist, uint8_t* votes);
+
+/**
+ * @brief 모아 둔 빈 값 중 [binBegin, binEnd) 에 드는 것만 HIST_LANES 개 부분 히스토그램에 누적
+ *
+ * 범위 밖 빈은 분기 없이 각 묶음의 마지막 칸 (binCount) 에 버립니다.
+ *
+ * @param votes collectBitsRow 가 기록한 빈 값
+ * @param count 빈 값 개수
+ * @param binBegin 누적할 첫 빈
+ * @param binEnd 누적할 마지막 빈 다음
+ * @param binCount 히스토그램 빈 개수
+ * @param[in,out] hist 부분 히스토그램 묶음 ((binCount + 1) * HIST_LANES 개)
+ */
+void accumulateVotes(const uint8_t* votes, size_t count, int binBegin, int binEnd, int binCount, uint32_t* hist);
+
+/**
+ * @brief 부분 히스토그램들을 첫 묶음에 합산
+ * @param[in,out] hist 부분 히스토그램 묶음 ((binCount + 1) * HIST_LANES 개)
+ * @param binCount 히스토그램 빈 개수
+ */
+void foldHistLanes(uint32_t* hist, int binCount);
+
+/**
+ * @brief 배포하는 파라미터 조합에 특화한 행 커널
+ *
+ * 빈 개수와 블러/침식 커널 크기를 컴파일 시간 상수로 두어 탭/이동 루프를 펼치고, 경계 열과 내부 열을 나누어
+ * 내부 루프에 분기가 없도록 합니다. 결과는 범용 커널과 비트 단위로 같습니다.
+ * 런타임 크기 인자는 범용 커널과 같은 함수 형식을 맞추기 위한 것으로 무시합니다.
+ * 블러 계수는 gaussianKernelFixedPoint 가 만드는 대칭 계수라고 가정합니다.
+ * accumulateRow 는 accumulateRowLanes 와 같은 부분 히스토그램 묶음에 누적합니다.
+ *
+ * @tparam BinCount 히스토그램 빈 개수
+ * @tparam BlurSize 가우시안 커널 크기 (홀수)
+ * @tparam ErodeSize 침식 구조 요소 크기
+ */
+template <int BinCount, int BlurSize, int ErodeSize>
+struct HOGKernel {
+    static void blurRowH(const uint8_t* src, int cols, int xBegin, int xEnd, const uint16_t* taps, int ksize,
+                         uint16_t* dst);
+    static void blurRowV(const uint16_t* const* rows, int cols, const uint16_t* taps, int ksize, uint8_t* dst);
+    static void erodeBitsRow(const uint64_t* const* rows, int rowCount, int cols, int xBegin, int xEnd, int ksize,
+                             uint64_t* tmp, uint64_t* out);
+    static int accumulateRow(const uint8_t* mask, const uint8_t* bins, int cols, int binCount, uint32_t* hist);
+};
+
+/**
+ * @brief 그래디언트/방향 빈 커널의 SIMD 변형 (값이 클수록 넓은 벡터)
+ */
+enum class SimdLevel {
+    Scalar,  // 기본 빌드 대상 (x86 이 아니거나 GCC/Clang 이 아닌 빌드는 항상 이 값)
+    SSE42,
+    AVX2,
+    AVX512   // AVX-512 F/BW/VL/DQ
+};
+
+/**
+ * @brief CPU 가 지원하는 가장 넓은 SIMD 수준 감지 (CPUID)
+ * @return 감지된 수준
+ */
+SimdLevel detectSimdLevel();
+
+/**
+ * @brief selectKernels 가 사용할 SIMD 수준
+ *
+ * setSimdLevel 로 정하지 않았다면 처음 호출될 때 환경 변수 VV_SIMD (scalar|sse4.2|avx2|avx512) 를 읽고,
+ * 값이 없거나 CPU 가 지원하지 않으면 detectSimdLevel 결과를 사용합니다.
+ *
+ * @return 활성 수준
+ */
+SimdLevel activeSimdLevel();
+
+/**
+ * @brief SIMD 수준 강제 지정 (이후 생성되는 ImageProcessor 부터 적용)
+ * @param level 사용할 수준
+ * @return CPU 가 지원하지 않아 적용하지 못하면 false
+ */
+bool setSimdLevel(SimdLevel level);
+
+/**
+ * @brief SIMD 수준 이름 (scalar, sse4.2, avx2, avx512)
+ * @param level 수준
+ * @return 이름 문자열
+ */
+const char* simdLevelName(SimdLevel level);
+
+/**
+ * @brief 이름으로 SIMD 수준 해석
+ * @param name simdLevelName 과 같은 형식의 이름
+ * @param[out] level 해석된 수준
+ * @return 알 수 없는 이름이면 false
+ */
+bool parseSimdLevel(const char* name, SimdLevel& level);
+
+/**
+ * @brief 행 커널 묶음 (범용 커널 또는 HOGKernel 특화 + SIMD 변형)
+ *
+ * accumulateRow 는 accumulateRowLanes 와 같이 HIST_LANES 개 부분 히스토그램에 누적합니다.
+ */
+struct KernelTable {
+    void (*blurRowH)(const uint8_t* src, int cols, int xBegin, int xEnd, const uint16_t* taps, int ksize,
+                     uint16_t* dst);
+    void (*blurRowV)(const uint16_t* const* rows, int cols, const uint16_t* taps, int ksize, uint8_t* dst);
+    void (*erodeBitsRow)(const uint64_t* const* rows, int rowCount, int cols, int xBegin, int xEnd, int ksize,
+                         uint64_t* tmp, uint64_t* out);
+    int (*accumulateRow)(const uint8_t* mask, const uint8_t* bins, int cols, int binCount, uint32_t* hist);
+    void (*sobelRow)(const uint8_t* up, const uint8_t* cur, const uint8_t* down, int cols, int xBegin, int xEnd,
+                     int16_t* gx, int16_t* gy);
+    void (*thresholdRow)(const int16_t* gx, const int16_t* gy, int cols, float magMin, float invRange,
+                         float threshold, uint8_t* mask, uint8_t* bins);
+    void (*thresholdRowInt)(const int16_t* gx, const int16_t* gy, int cols, int32_t thresholdSq,
+                            uint8_t* mask, uint8_t* bins);
+    void (*thresholdRowLut)(const int16_t* gx, const int16_t* gy, int cols, int32_t thresholdSq,
+                            uint8_t* mask, uint8_t* bins);
+    bool specialized;  // HOGKernel 특화 여부
+    SimdLevel simd;    // 그래디언트/방향 빈 커널의 SIMD 수준
+};
+
+/**
+ * @brief 파라미터 조합과 활성 SIMD 수준에 맞는 행 커널 선택
+ *
+ * 특화된 조합 (빈 개수/블러 크기/침식 크기: 180/11/3, 180/7/3, 180/15/3, 180/11/5, 90/11/3) 이면
+ * HOGKernel 특화를, 아니면 범용 커널을 고르고, 그래디언트/방향 빈 커널은 activeSimdLevel 변형으로 채웁니다.
+ * 모든 변형의 결과는 비트 단위로 같습니다.
+ *
+ * @param binCount 히스토그램 빈 개수
+ * @param blurSize 가우시안 계수 개수 (gaussianKernelFixedPoint 결과 크기)
+ * @param erodeSize 침식 구조 요소 크기
+ * @return 행 커널 묶음
+ */
+KernelTable selectKernels(int binCount, int blurSize, int erodeSize);
+
+} // namespace kernel
+} // namespace vv
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <fstream>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 #include <opencv2/videoio.hpp>
 #include <opencv2/highgui.hpp>
 #include "visual_vertical/Types.hpp"
+#include "visual_vertical/FrameQueue.hpp"
 
 namespace vv {
 
@@ -28,24 +32,107 @@ public:
 
     /**
      * @brief 비디오 입력 준비
+     *
+     * 카메라는 설정의 캡처 백엔드로 열고 (열 수 없으면 자동 선택으로 다시 시도), 픽셀 형식, 해상도, 프레임 속도,
+     * 드라이버 버퍼 개수를 요청한 뒤 실제로 적용된 값을 출력합니다. 파일 입력은 항상 자동 선택 백엔드를 사용합니다.
      * @return 성공 여부
      */
     bool openVideoSource();
 
+    /**
+     * @brief 미리 읽기 시작 (디코딩 스레드가 고정 용량 링에 프레임을 미리 채움)
+     *
+     * 시작한 뒤에는 readNextFrame 이 이미 디코딩된 프레임을 꺼내며, 캡처 객체는 디코딩 스레드만 사용합니다.
+     * 기본 모드에서는 링이 가득 차면 디코딩 스레드가 기다리므로 프레임을 잃지 않고,
+     * 최신 프레임 모드에서는 디코딩 스레드가 쉬지 않고 읽으며 readNextFrame 은 가장 최근 프레임만 꺼냅니다.
+     * @param depth 링 용량 (프레임 수)
+     * @param latestOnly 최신 프레임 모드 (실시간 카메라용, 밀린 프레임은 버림)
+     * @return 시작했는지 여부 (입력이 열려 있지 않으면 false)
+     */
+    bool startReadAhead(size_t depth, bool latestOnly = false);
+
+    /**
+     * @brief 미리 읽기 중지 (디코딩 스레드 종료, 링에 남은 프레임은 버림)
+     */
+    void stopReadAhead();
+
+    /**
+     * @brief 미리 읽기 링 (점유율 확인용)
+     * @return 미리 읽기 중이 아니면 nullptr
+     */
+    const FrameQueue* getFrameQueue() const;
+
     /**
      * @brief 다음 프레임 읽기
+     *
+     * headless 설정이면 캡처 백엔드에 색 변환 없는 원시 프레임을 요청하므로,
+     * 프레임 형식은 getFrameFormat() 으로 확인해야 합니다.
+     * 프레임 버퍼는 다음 읽기에서 재사용되므로 다음 호출 전까지만 유효합니다.
+     *
      * @param[out] frame 읽은 프레임이 저장될 Mat
      * @return 프레임을 성공적으로 읽었는지 여부
      */
     bool readNextFrame(cv::Mat& frame);
 
     /**
-     * @brief 결과 비디오 파일 준비
+     * @brief 다음 프레임을 디코딩하지 않고 건너뛰기 (grab 만 호출, 미리 읽기 중이면 디코딩된 프레임을 버림)
+     *
+     * getDroppedFrames 는 건너뛴 프레임 직전에 버려진 프레임 수로 바뀌고, getFrameTimestamp 는 그대로입니다.
+     * @return 프레임이 있었는지 여부
+     */
+    bool skipNextFrame();
+
+    /**
+     * @brief 마지막으로 읽은 프레임의 픽셀 형식
+     * @return 픽셀 형식 (원시 프레임을 요청하지 않았으면 BGR)
+     */
+    PixelFormat getFrameFormat() const;
+
+    /**
+     * @brief 마지막으로 읽은 프레임을 디코딩한 시각 (프레임 나이 계산용)
+     * @return 디코딩을 마친 시각
+     */
+    FrameQueue::Clock::time_point getFrameTimestamp() const;
+
+    /**
+     * @brief 마지막으로 읽거나 건너뛴 프레임 직전에 버려진 프레임 수 (최신 프레임 모드가 아니면 항상 0)
+     * @return 버려진 프레임 수
+     */
+    int getDroppedFrames() const;
+
+    /**
+     * @brief 입력을 연 뒤 첫 프레임을 읽을 때까지 걸린 시간
+     * @return 시간 (ms, 아직 프레임을 읽지 않았으면 음수)
+     */
+    double getStartupLatencyMs() const;
+
+    /**
+     * @brief 마지막으로 입력을 열 때 사용한 OpenCV 캡처 API
+     * @return cv::CAP_* 값 (파일 입력이거나 자동 선택으로 다시 시도했으면 cv::CAP_ANY)
+     */
+    int getCaptureApi() const;
+
+    /**
+     * @brief 설정의 캡처 백엔드에 해당하는 OpenCV 캡처 API
+     * @param backend 캡처 백엔드
+     * @return cv::CAP_* 값 (자동 선택이면 cv::CAP_ANY)
+     */
+    static int captureApi(CaptureBackend backend);
+
+    /**
+     * @brief 입력 영상의 프레임 속도 (미리 읽기 시작 전에 호출)
+     * @return 캡처가 보고한 프레임 속도 (알 수 없으면 30)
+     */
+    double getSourceFps() const;
+
+    /**
+     * @brief 결과 비디오 파일 준비 (미리 읽기 시작 전에 호출)
      * @param width 비디오 너비
      * @param height 비디오 높이
+     * @param fps 녹화 프레임 속도 (0 이하이면 입력 영상의 프레임 속도)
      * @return 성공 여부
      */
-    bool setupVideoWriter(int width, int height);
+    bool setupVideoWriter(int width, int height, double fps = 0.0);
 
     /**
      * @brief 프레임을 결과 비디오에 쓰기
@@ -68,6 +155,20 @@ public:
      */
     bool saveResultsToCSV(const std::vector<VVResult>& results);
 
+    /**
+     * @brief 처리 결과를 CSV 파일 끝에 이어서 기록 (첫 호출 시 파일을 열고 헤더 작성)
+     * @param results 기록할 결과 배열
+     * @param count 결과 개수
+     * @return 성공 여부
+     */
+    bool appendResultsToCSV(const VVResult* results, size_t count);
+
+    /**
+     * @brief 이어서 기록하던 CSV 파일 닫기
+     * @return 기록된 결과가 있었는지 여부
+     */
+    bool closeResultsCSV();
+
     /**
      * @brief VideoCapture 객체 얻기
      * @return VideoCapture 참조
@@ -87,7 +188,46 @@ private:
     cv::VideoCapture m_videoCapture;
     cv::VideoWriter m_videoWriter;
     std::string m_csvFilePath;
+    std::ofstream m_csvFile;                     // 결과 버퍼가 찰 때마다 이어서 기록하는 CSV
+    size_t m_csvRows = 0;                        // CSV 에 기록된 결과 개수
     std::string m_videoFilePath;
+    bool m_rawFrames = false;                    // 캡처 백엔드가 색 변환 없는 프레임을 주는지
+    PixelFormat m_frameFormat = PixelFormat::BGR;
+    FrameQueue::Clock::time_point m_frameTimestamp{};  // 마지막으로 읽은 프레임을 디코딩한 시각
+    int m_droppedFrames = 0;                     // 마지막으로 읽거나 건너뛴 프레임 직전에 버려진 프레임 수
+    FrameQueue::Clock::time_point m_openTime{};  // openVideoSource 호출 시각
+    double m_startupLatencyMs = -1.0;            // 입력을 연 뒤 첫 프레임까지 걸린 시간 (ms)
+    int m_captureApi = cv::CAP_ANY;              // 마지막으로 입력을 열 때 사용한 캡처 API
+    cv::Mat m_rawFrame;                          // 원시 프레임 (패킹된 YUV 의 휘도 추출용)
+    std::unique_ptr<FrameQueue> m_frameQueue;    // 미리 읽기 링 (미리 읽기 중이 아니면 비어 있음)
+    std::thread m_readThread;                    // 미리 읽기 디코딩 스레드
+    cv::Mat m_skippedFrame;                      // 미리 읽기 중 건너뛴 프레임 (링 버퍼와 교환하여 재사용)
+    
+    /**
+     * @brief 캡처 객체에서 프레임 하나 디코딩
+     * @param[out] frame 디코딩한 프레임
+     * @param[out] format 디코딩한 프레임의 픽셀 형식
+     * @return 프레임을 읽었는지 여부
+     */
+    bool decodeFrame(cv::Mat& frame, PixelFormat& format);
+    
+    /**
+     * @brief 미리 읽기 디코딩 스레드 본체
+     */
+    void readAheadLoop();
+    
+    /**
+     * @brief 카메라에 설정의 픽셀 형식, 해상도, 프레임 속도, 버퍼 개수를 요청하고 적용된 값 출력
+     */
+    void configureCamera();
+    
+    /**
+     * @brief 원시 프레임의 픽셀 형식 판별
+     * @param frame 색 변환 없이 읽은 프레임
+     * @param[out] format 판별된 픽셀 형식
+     * @return 지원하는 형식인지 여부
+     */
+    bool detectRawFormat(const cv::Mat& frame, PixelFormat& format) const;
     
     /**
      * @brief 현재 시간을 기반으로 타임스탬프 문자열 생성
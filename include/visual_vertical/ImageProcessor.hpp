@@ -1,8 +1,12 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <vector>
 #include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
 #include "visual_vertical/Types.hpp"
+#include "visual_vertical/HOGKernel.hpp"
 
 namespace vv {
 
@@ -26,6 +30,39 @@ public:
      */
     HOGResult computeHOG(const cv::Mat& image);
 
+    /**
+     * @brief HOG 계산 (결과 버퍼 재사용)
+     *
+     * 내부 작업 버퍼와 result 의 Mat/히스토그램은 첫 프레임 크기에 맞춰 한 번만 할당되고,
+     * 이후 같은 크기의 프레임에서는 힙 할당 없이 재사용됩니다.
+     *
+     * @param image 입력 이미지 (BGR, BGRA 또는 8비트 단일 채널 휘도)
+     * @param[out] result HOG 계산 결과
+     * @param output 출력 범위 (HistogramOnly 이면 디버그 영상을 만들지 않음)
+     */
+    void computeHOG(const cv::Mat& image, HOGResult& result, HOGOutput output = HOGOutput::Full);
+
+    /**
+     * @brief 픽셀 형식을 지정한 HOG 계산 (결과 버퍼 재사용)
+     *
+     * NV12/I420 프레임은 복사 없이 Y 평면만 사용하므로 색 변환이 필요 없습니다.
+     *
+     * @param image 입력 프레임
+     * @param format 입력 프레임 픽셀 형식
+     * @param[out] result HOG 계산 결과 (크기는 Y 평면 크기)
+     * @param output 출력 범위 (HistogramOnly 이면 디버그 영상을 만들지 않음)
+     */
+    void computeHOG(const cv::Mat& image, PixelFormat format, HOGResult& result,
+                    HOGOutput output = HOGOutput::Full);
+
+    /**
+     * @brief HOG 입력으로 쓸 영상 뷰 (평면 YUV 는 Y 평면, 그 외는 프레임 그대로, 복사 없음)
+     * @param frame 입력 프레임
+     * @param format 입력 프레임 픽셀 형식
+     * @return BGR(A) 또는 단일 채널 휘도 영상
+     */
+    static cv::Mat hogInput(const cv::Mat& frame, PixelFormat format);
+
     /**
      * @brief 이미지 크기 조정
      * @param image 입력 이미지
@@ -34,6 +71,14 @@ public:
      */
     cv::Mat resizeImage(const cv::Mat& image, int scale) const;
 
+    /**
+     * @brief 이미지 크기 조정 (출력 버퍼 재사용)
+     * @param image 입력 이미지
+     * @param scale 크기 조정 비율
+     * @param[out] resized 크기가 조정된 이미지
+     */
+    void resizeImage(const cv::Mat& image, int scale, cv::Mat& resized) const;
+
     /**
      * @brief 이미지 회전
      * @param image 입력 이미지
@@ -42,15 +87,41 @@ public:
      */
     cv::Mat rotateImage(const cv::Mat& image, double angle) const;
 
+    /**
+     * @brief 이미지 회전 (출력 버퍼 재사용)
+     * @param image 입력 이미지
+     * @param angle 회전 각도 (도)
+     * @param[out] rotated 회전된 이미지
+     */
+    void rotateImage(const cv::Mat& image, double angle, cv::Mat& rotated) const;
+
+    /**
+     * @brief 마지막 computeHOG 호출에서 다시 계산한 타일 수 (시간적 증분 모드 확인용)
+     * @return 다시 계산한 타일 수 (증분 모드가 아니면 전체 타일 수, 디버그 영상만 다시 기록한 타일은 제외)
+     */
+    int recomputedTileCount() const;
+
+    /**
+     * @brief 시각화 캔버스를 준비하고 보정 이미지 패널 영역 반환
+     *
+     * 반환된 뷰에 rotateImage 로 바로 그리면 createVisualization 에서 보정 이미지를 복사하지 않습니다.
+     * @param frameSize 입력 프레임 크기
+     * @param histogramRows 히스토그램 패널 높이
+     * @return 캔버스의 보정 이미지 영역 (CV_8UC3 뷰)
+     */
+    cv::Mat calibratedPanel(const cv::Size& frameSize, int histogramRows);
+
     /**
      * @brief 결과 시각화 이미지 생성
+     *
+     * 미리 할당한 캔버스의 패널 영역마다 직접 그리므로 크기가 바뀌지 않으면 프레임마다 할당하지 않습니다.
      * @param inputImage 원본 입력 이미지
-     * @param calibratedImage 보정된 이미지
+     * @param calibratedImage 보정된 이미지 (calibratedPanel 이 반환한 뷰이면 복사 생략)
      * @param hogResult HOG 계산 결과
      * @param vvResult VV 추정 결과
      * @param histogramImage 히스토그램 이미지
      * @param fps 프레임 속도
-     * @return 모든 결과가 결합된 시각화 이미지
+     * @return 모든 결과가 결합된 시각화 이미지 (내부 버퍼를 공유하므로 다음 호출 전까지만 유효)
      */
     cv::Mat createVisualization(
         const cv::Mat& inputImage, 
@@ -59,11 +130,273 @@ public:
         const VVResult& vvResult,
         const cv::Mat& histogramImage,
         float fps = 0.0f
-    ) const;
+    );
 
 private:
+    // 반복 상자 블러의 단계별 결과 (0: 그레이 변환 + 가로 상자 필터, p: 세로 상자 필터 p 회 적용)
+    struct BoxLevel {
+        std::vector<uint16_t> ring;               // 결과 행 순환 버퍼 (다음 단계의 세로 창 + 1 행)
+        std::vector<int> ringRow;                 // 순환 버퍼 슬롯별 원본 행 번호
+        std::vector<uint32_t> acc;                // 이 단계를 만드는 열별 세로 이동 합 (p >= 1)
+        int accRow = -1;                          // acc 가 중심으로 하는 행 (-1 이면 다시 초기화)
+    };
+
+    // 타일(가로 띠) 하나가 사용하는 작업 버퍼
+    // 타일마다 자기 순환 버퍼와 부분 히스토그램을 가지므로 스레드 수와 무관하게 같은 결과가 나온다
+    struct TileWorkspace {
+        int rowBegin = 0, rowEnd = 0;             // 담당 행 범위 [rowBegin, rowEnd)
+        std::vector<uint8_t> grayRow;             // 그레이 변환 행
+        std::vector<uint16_t> blurRing;           // 가로 블러 결과 순환 버퍼
+        std::vector<int> blurRingRow;             // 순환 버퍼 슬롯별 원본 행 번호
+        std::vector<const uint16_t*> blurWindow;  // 세로 블러 창
+        std::vector<uint16_t> boxTmp;             // 상자 블러: 가로 단계 사이의 행 버퍼 (2 행)
+        std::vector<BoxLevel> boxLevels;          // 상자 블러: 단계별 결과
+        int boxBegin = 0, boxEnd = 0;             // 상자 블러: 타일이 계산하는 열 범위
+        std::vector<int16_t> gx, gy;              // 그래디언트 행
+        std::vector<uint8_t> maskRow;             // 임계값 결과 마스크 행 (0/1)
+        std::vector<uint64_t> maskBits;           // 침식 창 크기의 비트 마스크 순환 버퍼 (행마다 maskWords(cols) 워드)
+        std::vector<uint8_t> binRing;             // 침식 창 크기의 방향 빈 순환 버퍼
+        std::vector<uint64_t> erodeBitsTmp, erodedBits;
+        std::vector<const uint64_t*> bitWindow;   // 비트 마스크 세로 침식 창
+        std::vector<uint8_t> erodeTmp;            // 격자 샘플링: 바이트 마스크 침식 버퍼
+        std::vector<const uint8_t*> erodeWindow;
+        std::vector<uint8_t> grayRing;            // 격자 샘플링: 그레이 행 순환 버퍼
+        std::vector<int> grayRingRow;             // 순환 버퍼 슬롯별 원본 행 번호
+        std::vector<const uint8_t*> grayWindow;   // 세로 합성 필터 창
+        std::vector<int32_t> vSmooth, vDeriv;     // 세로 합성 필터 결과
+        std::vector<uint8_t> thumb;               // 시간적 모드: 마지막으로 계산한 프레임의 축소 휘도
+        bool changed = true;                      // 시간적 모드: 입력이 바뀐 타일
+        bool blurDirty = true;                    // 블러를 다시 계산할 타일
+        bool histDirty = true;                    // 그래디언트/히스토그램을 다시 계산할 타일
+        bool planesStale = true;                  // 마지막으로 기록한 디버그 영상의 이 타일 행이 현재 프레임과 다름
+        std::vector<uint32_t> counts;             // 부분 히스토그램
+        std::vector<uint32_t> coarseCounts;       // 2단계 히스토그램: 거친 부분 히스토그램
+        std::vector<uint8_t> fineVotes;           // 2단계 히스토그램: 투표한 픽셀의 빈 값 (votes 개)
+        int grayMin = 0, grayMax = 0;             // 블러된 영상 값 범위
+        int32_t minSq = 0, maxSq = 0;             // 그래디언트 크기 제곱 범위
+        long long votes = 0;                      // 침식 후 남은 픽셀 수
+    };
+
+    // 프레임 전체에 공통인 임계값 파라미터
+    struct ThresholdParams {
+        float magMin;
+        float invRange;
+        float threshold;
+        float gradScale;
+        int32_t thresholdSq;  // 정수 경로용 그래디언트 크기 제곱 임계값
+        double magThreshold;  // 그래디언트 크기 임계값 (시간적 모드의 변화량 판정용)
+    };
+
+    // 행별로 계산할 열 범위 [begin, end)
+    struct ColumnSpan {
+        int begin = 0, end = 0;
+        bool empty() const { return begin >= end; }
+    };
+
+    // 프레임 간에 재사용하는 HOG 작업 버퍼 (첫 프레임 크기에 맞춰 할당)
+    struct Workspace {
+        cv::Size size;
+        cv::Mat blurred;                          // 블러된 8비트 그레이 영상
+        std::vector<TileWorkspace> tiles;         // 고정 높이 타일 목록
+        
+        // 관심 영역과 단계별로 필요한 열 범위 (각 단계의 이웃 halo 포함)
+        cv::Mat selection;                        // 선택 마스크 (0/1, 관심 영역이 없으면 비어 있음)
+        std::vector<ColumnSpan> selectSpan;       // 히스토그램에 투표하는 열
+        std::vector<uint8_t> selectFull;          // selectSpan 안이 모두 선택된 행인지
+        std::vector<uint64_t> selectBits;         // 비트로 묶은 선택 마스크 (행마다 maskWords(cols) 워드, 관심 영역이 없으면 비어 있음)
+        std::vector<ColumnSpan> threshSpan;       // 그래디언트/임계값 (침식 halo)
+        std::vector<ColumnSpan> blurSpan;         // 블러 결과 (Sobel halo)
+        std::vector<ColumnSpan> hblurSpan;        // 가로 블러 결과 (세로 블러 halo)
+        std::vector<ColumnSpan> graySpan;         // 그레이 변환 (가로 블러 halo)
+        
+        // 격자 샘플링 (samplingStride > 1), 격자점 (ly, lx) 는 픽셀 (ly * stride, lx * stride)
+        int stride = 1;
+        cv::Size lattice;                         // 격자 크기
+        int latErodeSize = 1;                     // 격자 단위 침식 크기 (픽셀 단위 침식과 비슷한 범위)
+        cv::Mat latGx, latGy;                     // 격자점 그래디언트 (CV_16S)
+        cv::Mat latMask, latBins, latEroded;      // 격자점 임계값/방향/침식 결과 (CV_8U)
+        cv::Mat latSelection;                     // 격자점 선택 마스크 (관심 영역이 없으면 비어 있음)
+        std::vector<ColumnSpan> latSelectSpan;    // 격자 열 단위 투표 범위
+        std::vector<uint8_t> latSelectFull;
+        std::vector<ColumnSpan> latThreshSpan;    // 격자 열 단위 그래디언트/임계값 범위 (침식 halo)
+        std::vector<ColumnSpan> latGraySpan;      // 픽셀 열 단위 그레이 변환 범위 (합성 필터 halo)
+        
+        // 시간적 증분 모드
+        bool temporalValid = false;               // 이전 프레임 결과를 재사용할 수 있는지
+        const uchar* lastPlaneData = nullptr;     // 마지막으로 디버그 영상을 기록한 결과 버퍼 (다른 버퍼면 모든 타일의 디버그 영상을 다시 기록)
+        ThresholdParams lastParams{};             // 이전 프레임에 사용한 임계값
+        std::vector<uint64_t> totalCounts;        // 전체 히스토그램 (타일 부분 히스토그램의 합)
+        std::vector<uint64_t> coarseTotal;        // 2단계 히스토그램: 전체 거친 히스토그램
+        long long totalVotes = 0;
+        int recomputedTiles = 0;                  // 마지막 프레임에서 다시 계산한 타일 수
+    };
+
+    // 프레임 간에 재사용하는 시각화 캔버스와 패널 영역 (패널은 canvas 를 가리키는 뷰)
+    struct VisualizationBuffers {
+        cv::Mat canvas;
+        cv::Mat inputPanel, calibratedPanel;       // 상단: 원본 + 보정
+        cv::Mat magPanel, magFilteredPanel;        // 중간: HOG 매그니튜드 + 필터링된 매그니튜드
+        cv::Mat histPanel;                         // 하단: 히스토그램
+        cv::Mat bgrScratch;                        // 패널과 크기/형식이 다른 8비트 입력을 변환할 때만 사용
+        cv::Mat magResized;                        // 패널과 크기가 다른 매그니튜드를 조정할 때만 사용 (float)
+        cv::Mat mag8U;                             // 매그니튜드의 8비트 회색조 변환
+    };
+
     HOGParams m_params;
-    cv::Mat m_erodeKernel;
+    std::vector<uint16_t> m_blurTaps;
+    kernel::KernelTable m_kernels;                  // 파라미터 조합과 SIMD 수준에 맞춰 고른 행 커널
+    std::vector<int> m_boxRadii;                     // 반복 상자 블러 반지름 (상자 블러를 쓰지 않으면 비어 있음)
+    int m_blurRadius = 0;                            // 블러 결과 한 픽셀이 의존하는 입력 반지름
+    int m_coarseCount = 0;                           // 2단계 히스토그램의 거친 빈 개수 (0 이면 사용 안 함)
+    std::array<uint8_t, 256> m_coarseOf{};           // 빈 값별 거친 빈 인덱스
+    std::vector<int32_t> m_smoothTaps, m_derivTaps;  // 블러 + Sobel 합성 계수 (격자 샘플링용)
+    Workspace m_ws;
+    VisualizationBuffers m_vis;
+
+    /**
+     * @brief 프레임 크기에 맞춰 작업 버퍼 준비 (크기가 바뀔 때만 할당)
+     * @param size 프레임 크기
+     */
+    void prepareWorkspace(const cv::Size& size);
+
+    /**
+     * @brief 프레임 크기와 히스토그램 높이에 맞춰 시각화 캔버스와 패널 영역 준비 (크기가 바뀔 때만 할당)
+     * @param frameSize 입력 프레임 크기
+     * @param histogramRows 히스토그램 패널 높이
+     */
+    void prepareVisualization(const cv::Size& frameSize, int histogramRows);
+
+    /**
+     * @brief 관심 영역 선택 마스크와 단계별 열 범위 계산 (프레임 크기가 바뀔 때만 호출)
+     */
+    void prepareSelection();
+
+    /**
+     * @brief 격자 샘플링 작업 버퍼와 격자 단위 열 범위 준비 (프레임 크기가 바뀔 때만 호출)
+     */
+    void prepareLattice();
+
+    /**
+     * @brief 각 행의 열 범위를 이웃 창만큼 넓혀 창이 읽는 행에 합침
+     * @param in 출력 행별 열 범위
+     * @param up 창이 위로 읽는 행 수
+     * @param down 창이 아래로 읽는 행 수
+     * @param left 창이 왼쪽으로 읽는 열 수
+     * @param right 창이 오른쪽으로 읽는 열 수
+     * @param cols 열 개수
+     * @param reflect true 이면 영상 밖 행을 BORDER_REFLECT_101 로 접고, false 이면 잘라냄
+     * @param[out] out 입력 행별 열 범위
+     */
+    static void dilateSpans(const std::vector<ColumnSpan>& in, int up, int down, int left, int right,
+                            int cols, bool reflect, std::vector<ColumnSpan>& out);
+
+    /**
+     * @brief 타일의 축소 휘도를 마지막으로 계산한 프레임과 비교해 변경 여부 판정 (시간적 모드)
+     * @param image 입력 이미지 (BGR 또는 BGRA)
+     * @param tile 타일 작업 버퍼
+     * @param compare false 이면 비교 없이 변경된 것으로 처리
+     */
+    void detectChangeTile(const cv::Mat& image, TileWorkspace& tile, bool compare);
+
+    /**
+     * @brief 변경된 타일에서 블러/히스토그램 halo 가 닿는 타일을 다시 계산 대상으로 표시
+     * @param all true 이면 모든 타일을 다시 계산
+     */
+    void markDirtyTiles(bool all);
+
+    /**
+     * @brief 타일 범위의 그레이스케일 변환과 가우시안 블러를 행 단위로 수행하여 m_ws.blurred 에 저장
+     * @param image 입력 이미지 (BGR 또는 BGRA)
+     * @param tile 타일 작업 버퍼
+     */
+    void blurTile(const cv::Mat& image, TileWorkspace& tile);
+
+    /**
+     * @brief 타일 범위의 그레이스케일 변환과 반복 상자 블러를 이동 합으로 수행하여 m_ws.blurred 에 저장
+     * @param image 입력 이미지 (BGR 또는 BGRA)
+     * @param tile 타일 작업 버퍼
+     */
+    void boxBlurTile(const cv::Mat& image, TileWorkspace& tile);
+
+    /**
+     * @brief 상자 블러 단계의 결과 행 (순환 버퍼에 없으면 계산)
+     * @param image 입력 이미지
+     * @param tile 타일 작업 버퍼
+     * @param level 단계 (0: 가로 상자 필터, 1 이상: 세로 상자 필터 적용 횟수)
+     * @param y 원본 행 번호
+     * @return 8비트 소수부 고정소수점 행 (전체 열 기준 포인터)
+     */
+    const uint16_t* boxLevelRow(const cv::Mat& image, TileWorkspace& tile, int level, int y);
+
+    /**
+     * @brief 상자 블러 단계의 세로 이동 합을 행 y 중심 창으로 옮김
+     * @param image 입력 이미지
+     * @param tile 타일 작업 버퍼
+     * @param level 이동 합을 갱신할 단계 (1 이상)
+     * @param y 창 중심 행
+     */
+    void boxSlide(const cv::Mat& image, TileWorkspace& tile, int level, int y);
+
+    /**
+     * @brief 타일 범위의 그래디언트 크기 범위 계산 (1차 패스)
+     * @param tile 타일 작업 버퍼
+     */
+    void gradientRangeTile(TileWorkspace& tile);
+
+    /**
+     * @brief 타일 범위의 임계값/침식/히스토그램 계산 (2차 패스)
+     * @param tile 타일 작업 버퍼
+     * @param params 임계값 파라미터
+     * @param[out] result 디버그 영상이 기록될 HOG 결과
+     * @param vote false 이면 디버그 영상만 다시 기록하고 타일의 부분 히스토그램은 그대로 둠
+     */
+    void histogramTile(TileWorkspace& tile, const ThresholdParams& params, HOGResult& result, bool vote);
+
+    /**
+     * @brief 2단계 히스토그램: 거친 히스토그램의 피크 주변 창만 타일별 부분 히스토그램으로 다시 집계
+     * @param[out] result 거친 히스토그램이 기록될 HOG 결과
+     */
+    void refineHistogram(HOGResult& result);
+
+    /**
+     * @brief 정밀도 설정에 맞는 임계값/방향 빈 행 커널 호출
+     * @param gx x 방향 그래디언트
+     * @param gy y 방향 그래디언트
+     * @param cols 열 개수
+     * @param params 임계값 파라미터
+     * @param[out] mask 임계값 통과 여부
+     * @param[out] bins 방향 빈 인덱스
+     */
+    void thresholdRow(const int16_t* gx, const int16_t* gy, int cols, const ThresholdParams& params,
+                      uint8_t* mask, uint8_t* bins) const;
+
+    /**
+     * @brief 타일 범위 격자점의 그래디언트와 크기 범위 계산 (격자 샘플링 1차 패스)
+     * @param image 입력 이미지 (BGR 또는 BGRA)
+     * @param tile 타일 작업 버퍼
+     */
+    void latticeGradientTile(const cv::Mat& image, TileWorkspace& tile);
+
+    /**
+     * @brief 타일 범위 격자점의 임계값과 방향 빈 계산
+     * @param tile 타일 작업 버퍼
+     * @param params 임계값 파라미터
+     */
+    void latticeThresholdTile(TileWorkspace& tile, const ThresholdParams& params);
+
+    /**
+     * @brief 타일 범위 격자점의 침식과 부분 히스토그램 계산
+     * @param tile 타일 작업 버퍼
+     */
+    void latticeHistogramTile(TileWorkspace& tile);
+
+    /**
+     * @brief 격자점 결과를 타일 범위의 디버그 영상에 최근접 방식으로 기록
+     * @param tile 타일 작업 버퍼
+     * @param params 임계값 파라미터
+     * @param[out] result 디버그 영상이 기록될 HOG 결과
+     */
+    void latticeDebugTile(TileWorkspace& tile, const ThresholdParams& params, HOGResult& result);
 
     /**
      * @brief 이미지에 VV 각도 선 그리기
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <opencv2/core.hpp>
+#include "visual_vertical/Types.hpp"
+
+namespace vv {
+
+/**
+ * @brief 렌더링 스레드에 넘기는 프레임 스냅샷
+ */
+struct RenderSnapshot {
+    cv::Mat frame;        // HOG 입력 프레임 (크기 조정 후)
+    HOGResult hog;        // HOG 결과 (디버그 영상 포함)
+    VVResult vv;          // VV 추정 결과
+    float fps = 0.0f;     // 추정 루프의 프레임 속도
+    bool repeat = false;  // 건너뛴 프레임: 다시 그리지 않고 직전 캔버스를 한 번 더 기록
+};
+
+/**
+ * @brief 추정 루프와 분리된 시각화 렌더링 스레드
+ *
+ * 추정 루프는 렌더링할 차례인 프레임의 스냅샷만 큐에 넣고 바로 다음 프레임으로 넘어갑니다.
+ * 기록 콜백이 없으면 큐는 최신 값 우편함 (길이 1) 이라, 렌더링 스레드가 아직 이전 스냅샷을 그리는 중이면
+ * 우편함의 스냅샷은 새 것으로 교체되고 (중간 프레임은 버림) 추정 루프는 렌더링을 기다리지 않습니다.
+ * 녹화할 때는 녹화 영상에서 프레임이 빠지지 않도록 큐가 가득 차면 post 가 자리가 날 때까지 기다립니다.
+ * 스냅샷 슬롯은 생성할 때 한 번만 만들어 돌려 쓰므로 크기가 같으면 할당도 없습니다.
+ *
+ * HighGUI 백엔드 (Cocoa, 빌드에 따라 Qt) 는 창 표시와 키 입력을 주 스레드에서만 허용하므로,
+ * 렌더링 스레드는 합성한 캔버스를 표시 우편함에 넘기기만 하고 표시는 주 스레드가 takeDisplayFrame 으로 가져가서 합니다.
+ */
+class RenderThread {
+public:
+    /**
+     * @brief 렌더링 콜백 (렌더링 스레드에서 호출, 창 표시는 하지 않음)
+     * @param snapshot 그릴 스냅샷
+     * @return 합성한 캔버스 (표시 우편함에 복사됨, 비어 있으면 표시하지 않음)
+     */
+    using RenderCallback = std::function<cv::Mat(const RenderSnapshot& snapshot)>;
+
+    /**
+     * @brief 기록 콜백 (렌더링 스레드에서 합성한 캔버스마다 순서대로 호출, 예: 비디오 쓰기)
+     * @param canvas 합성한 캔버스 (건너뛴 프레임이면 직전 캔버스)
+     */
+    using FrameSink = std::function<void(const cv::Mat& canvas)>;
+
+    /**
+     * @brief 생성자
+     * @param render 렌더링 콜백
+     * @param maxRate 최대 렌더링 속도 (Hz, 0 이하이면 제한 없음)
+     * @param every 입력 프레임 n 개마다 한 번 렌더링 (1 이하이면 매 프레임)
+     * @param sink 기록 콜백 (비어 있으면 기록하지 않고 밀린 스냅샷은 버림)
+     * @param recordQueue 기록할 때 렌더링을 기다리는 스냅샷 큐 길이 (1 미만이면 1)
+     */
+    RenderThread(RenderCallback render, double maxRate = 0.0, int every = 1,
+                 FrameSink sink = FrameSink(), size_t recordQueue = 4);
+
+    /**
+     * @brief 소멸자 (스레드 정지)
+     */
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    /**
+     * @brief 렌더링 스레드 시작
+     */
+    void start();
+
+    /**
+     * @brief 큐에 남은 스냅샷을 모두 그린 뒤 렌더링 스레드 정지
+     */
+    void stop();
+
+    /**
+     * @brief 이번 입력 프레임을 렌더링할 차례인지 (건너뛴 프레임을 포함해 입력 프레임마다 한 번 호출)
+     *
+     * 렌더링할 차례가 아닌 프레임은 스냅샷을 복사하지 않으며, 디버그 영상 계산도 생략할 수 있습니다.
+     * @return 렌더링할 차례이면 true (이어서 post 또는 postRepeat 호출)
+     */
+    bool frameDue();
+
+    /**
+     * @brief 스냅샷을 큐에 넣기 (기록하지 않으면 렌더링을 기다리지 않음)
+     * @param frame HOG 입력 프레임
+     * @param hog HOG 결과
+     * @param vv VV 추정 결과
+     * @param fps 추정 루프의 프레임 속도
+     */
+    void post(const cv::Mat& frame, const HOGResult& hog, const VVResult& vv, float fps);
+
+    /**
+     * @brief 건너뛴 프레임 자리에 직전 캔버스를 한 번 더 기록하도록 큐에 넣기 (복사 없음, 기록하지 않으면 무시)
+     */
+    void postRepeat();
+
+    /**
+     * @brief 마지막으로 가져간 뒤 새로 합성한 캔버스 가져오기 (주 스레드에서 호출, 기다리지 않음)
+     *
+     * 우편함의 캔버스와 canvas 의 이전 버퍼를 교환하므로, 같은 Mat 을 계속 넘기면 크기가 같을 때 할당이 없습니다.
+     * @param[in,out] canvas 표시할 캔버스
+     * @return 새 캔버스가 있으면 true
+     */
+    bool takeDisplayFrame(cv::Mat& canvas);
+
+    /**
+     * @brief 지금까지 렌더링한 스냅샷 수
+     */
+    long long renderedCount() const { return m_rendered.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 렌더링이 밀려 그리지 않고 버린 스냅샷 수 (기록할 때는 항상 0)
+     */
+    long long droppedCount() const { return m_dropped; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 추정 루프 슬롯을 큐에 넣고 새 추정 루프 슬롯 받기
+     */
+    void enqueueBack();
+
+    /**
+     * @brief 렌더링 스레드 본체
+     */
+    void run();
+
+    RenderCallback m_render;
+    FrameSink m_sink;
+    Clock::duration m_minPeriod{};            // 렌더링 사이 최소 간격 (0 이면 제한 없음)
+    int m_every;
+    long long m_frameIndex = 0;               // 입력 프레임 수 (frameDue 호출 수)
+    Clock::time_point m_lastDue{};
+    long long m_dropped = 0;
+
+    // 스냅샷 슬롯: 추정 루프가 채우는 슬롯, 렌더링 중인 슬롯, 큐에 든 슬롯, 빈 슬롯
+    std::vector<RenderSnapshot> m_slots;
+    int m_back = 0;
+    int m_front = 1;
+    std::vector<int> m_queue;                 // 큐에 든 슬롯 번호 (원형 버퍼)
+    size_t m_queueHead = 0;
+    size_t m_queueCount = 0;
+    std::vector<int> m_free;                  // 빈 슬롯 번호
+    bool m_stopping = false;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond;           // 스냅샷이 들어옴 (렌더링 스레드가 기다림)
+    std::condition_variable m_spaceCond;      // 큐에 자리가 남 (기록할 때 추정 루프가 기다림)
+    std::thread m_thread;
+    std::atomic<long long> m_rendered{0};
+    cv::Mat m_lastCanvas;                     // 직전에 합성한 캔버스 (건너뛴 프레임 기록용, 렌더링 스레드 전용)
+
+    // 표시 우편함: 렌더링 스레드가 채우는 캔버스와 주 스레드가 가져갈 캔버스
+    cv::Mat m_displayBack;
+    cv::Mat m_displayPending;
+    bool m_hasDisplay = false;
+    std::mutex m_displayMutex;
+};
+
+} // namespace vv
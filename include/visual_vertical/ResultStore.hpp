@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "visual_vertical/Types.hpp"
+
+namespace vv {
+
+/**
+ * @brief 고정 용량 VV 결과 링 버퍼
+ *
+ * 생성 시 한 번만 메모리를 할당하므로 무기한 실행해도 메모리 사용량이 일정합니다.
+ * 비움 콜백이 있으면 버퍼가 가득 찰 때마다 모인 결과를 순서대로 콜백에 넘기고 비우며 (CSV 일괄 기록 등),
+ * 없으면 가장 오래된 결과를 덮어써 최근 결과만 유지합니다.
+ */
+class ResultStore {
+public:
+    /**
+     * @brief 비움 콜백
+     * @param results 오래된 순서의 연속 결과
+     * @param count 결과 개수
+     */
+    using DrainCallback = std::function<void(const VVResult* results, size_t count)>;
+
+    /**
+     * @brief 생성자
+     * @param capacity 버퍼 용량 (최소 1)
+     * @param drain 비움 콜백 (비어 있으면 가장 오래된 결과를 덮어씀)
+     */
+    explicit ResultStore(size_t capacity = 1024, DrainCallback drain = nullptr);
+
+    /**
+     * @brief 결과 추가 (가득 차 있으면 비우거나 가장 오래된 결과를 덮어씀)
+     * @param result 추가할 결과
+     */
+    void push(const VVResult& result);
+
+    /**
+     * @brief 버퍼에 남은 결과를 비움 콜백에 넘기고 비우기 (콜백이 없으면 아무 일도 하지 않음)
+     */
+    void flush();
+
+    /**
+     * @brief 버퍼에 있는 결과 얻기
+     * @param index 0 이 가장 오래된 결과
+     * @return 결과 참조
+     */
+    const VVResult& operator[](size_t index) const;
+
+    /**
+     * @brief 가장 최근 결과 (버퍼가 비어 있으면 안 됨)
+     * @return 결과 참조
+     */
+    const VVResult& latest() const;
+
+    /**
+     * @brief 버퍼에 있는 결과 개수
+     */
+    size_t size() const { return m_size; }
+
+    /**
+     * @brief 버퍼 용량
+     */
+    size_t capacity() const { return m_buffer.size(); }
+
+    /**
+     * @brief 지금까지 추가된 전체 결과 개수
+     */
+    size_t totalCount() const { return m_total; }
+
+    /**
+     * @brief 비움 콜백 없이 덮어써서 버린 결과 개수
+     */
+    size_t droppedCount() const { return m_dropped; }
+
+private:
+    std::vector<VVResult> m_buffer; // 고정 크기 저장 공간
+    DrainCallback m_drain;
+    size_t m_head = 0;              // 가장 오래된 결과 위치
+    size_t m_size = 0;
+    size_t m_total = 0;
+    size_t m_dropped = 0;
+};
+
+} // namespace vv
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+#include <opencv2/core.hpp>
+#include "visual_vertical/Types.hpp"
+#include "visual_vertical/ImageProcessor.hpp"
+
+namespace vv {
+
+/**
+ * @brief 신뢰도 기반 거친-세밀 다중 해상도 HOG 계산
+ *
+ * 입력 영상을 pyrDown 으로 줄인 가장 거친 단계에서 먼저 히스토그램을 계산하고,
+ * 피크 선명도 (VVEstimator::peakConfidence) 가 기준보다 낮을 때만 다음 (더 세밀한) 단계에서 다시 계산합니다.
+ * 단계마다 ImageProcessor 를 따로 두므로 작업 버퍼는 단계별 크기로 한 번만 할당됩니다.
+ */
+class ScaleCascade {
+public:
+    /**
+     * @brief 생성자
+     * @param params HOG 계산 파라미터 (관심 영역 사각형은 입력 해상도 좌표, 단계마다 축소됨)
+     * @param levels 시도할 단계 (pyrDown 횟수, 순서와 무관하게 거친 단계부터 시도)
+     * @param confidenceThreshold 이 신뢰도 이상이면 더 세밀한 단계로 가지 않음
+     */
+    ScaleCascade(const HOGParams& params, const std::vector<int>& levels, double confidenceThreshold);
+
+    /**
+     * @brief 다중 해상도 HOG 계산 (결과 버퍼 재사용)
+     * @param image 입력 영상 (BGR, BGRA 또는 8비트 단일 채널 휘도)
+     * @param[out] result 마지막으로 계산한 단계의 HOG 결과 (디버그 영상은 그 단계 크기)
+     * @param output 출력 범위
+     * @return 결과를 계산한 단계 (pyrDown 횟수)
+     */
+    int computeHOG(const cv::Mat& image, HOGResult& result, HOGOutput output = HOGOutput::Full);
+
+    /**
+     * @brief 마지막 computeHOG 에서 결과를 낸 단계의 신뢰도
+     */
+    double confidence() const { return m_confidence; }
+
+    /**
+     * @brief 시도하는 단계 목록 (거친 단계부터)
+     */
+    const std::vector<int>& levels() const { return m_levels; }
+
+private:
+    std::vector<int> m_levels;                 // 내림차순 pyrDown 횟수
+    double m_threshold;
+    std::vector<ImageProcessor> m_processors;  // 단계별 처리기 (m_levels 와 같은 순서)
+    std::vector<cv::Mat> m_pyramid;            // m_pyramid[l] = 입력을 l 번 pyrDown 한 영상 (l >= 1)
+    double m_confidence = 0.0;
+};
+
+} // namespace vv
@@ -9,6 +9,28 @@ namespace vv {
 // 시간 형식 상수
 const std::string ISO_TIME_FORMAT = "%Y%m%d_%H%M%S";
 
+// 블러 방식
+enum class BlurBackend {
+    Gaussian, // 고정소수점 가우시안 커널 (cv::GaussianBlur 와 비트 단위로 같음, 비용이 커널 크기에 비례)
+    Box       // 3회 반복 상자 필터 근사 (이동 합으로 계산하여 비용이 커널 크기와 무관)
+};
+
+// 카메라 캡처 백엔드 (파일 입력은 항상 자동 선택)
+enum class CaptureBackend {
+    Auto,  // OpenCV 가 사용 가능한 백엔드를 자동 선택
+    V4L2,  // Linux Video4Linux2 (mmap 스트리밍 버퍼)
+    DShow, // Windows DirectShow
+    MSMF   // Windows Media Foundation
+};
+
+// 입력 프레임 픽셀 형식
+enum class PixelFormat {
+    BGR,  // 8비트 BGR 또는 BGRA
+    Gray, // 8비트 단일 채널 휘도
+    NV12, // Y 평면 + UV 교차 평면 (CV_8UC1, 높이 * 3/2 행)
+    I420  // Y 평면 + U 평면 + V 평면 (CV_8UC1, 높이 * 3/2 행)
+};
+
 // 프로그램 설정 구조체
 struct Config {
     bool useCamera = false;
@@ -16,6 +38,42 @@ struct Config {
     std::string inputFilePath = "./test.mp4";
     int scale = 2;
     bool saveResults = true;
+    std::vector<cv::Rect> roiRects;     // HOG 계산 영역 (원본 프레임 좌표, 비어 있으면 전체)
+    std::string roiMaskPath;            // HOG 계산 영역 마스크 영상 경로 (0이 아닌 픽셀만 사용)
+    int samplingStride = 1;             // HOG 그래디언트 격자 샘플링 간격
+    bool temporal = false;              // 변경된 타일만 다시 계산하는 시간적 증분 모드
+    BlurBackend blurBackend = BlurBackend::Gaussian;  // 블러 방식
+    bool headless = false;              // 시각화 없이 VV 만 계산 (캡처 장치에 원시 휘도 요청)
+    std::string simd;                   // HOG 커널 SIMD 수준 강제 지정 (비어 있으면 VV_SIMD 또는 CPU 감지)
+    int resultBufferSize = 1024;        // 결과 버퍼 용량 (가득 차면 CSV 에 이어서 기록)
+    int adaptiveInterval = 0;           // 장면이 안정적일 때 측정 간격 상한 (1 이하이면 매 프레임 측정)
+    double sceneChangeThreshold = 2.0;  // 적응형 건너뛰기의 장면 변화 판정 기준 (축소 휘도의 샘플당 평균 절대 차이)
+    int coarseBinWidth = 1;             // 2단계 히스토그램의 거친 빈 너비 (1 이하이면 사용 안 함)
+    std::vector<int> cascadeLevels;     // 다중 해상도 단계 (pyrDown 횟수, 거친 단계부터 시도, 비어 있으면 사용 안 함)
+    double cascadeConfidence = 0.25;    // 이 신뢰도 이상이면 더 세밀한 단계로 가지 않음
+    double renderRate = 0.0;            // 시각화 렌더링 최대 속도 (Hz, 0 이하이면 제한 없음)
+    int renderEvery = 1;                // 입력 프레임 n 개마다 한 번 렌더링 (1 이하이면 매 프레임)
+    int readAhead = 0;                  // 미리 디코딩해 둘 프레임 수 (0 이면 처리 루프에서 직접 디코딩)
+    bool latestFrame = false;           // 캡처 스레드가 계속 읽고 처리 루프는 가장 최근 프레임만 사용 (밀린 프레임은 버림)
+    CaptureBackend captureBackend = CaptureBackend::Auto;  // 카메라 캡처 백엔드
+    std::string captureFourcc;          // 카메라에 요청할 픽셀 형식 (YUYV, MJPG, GREY 등, 비어 있으면 드라이버 기본값)
+    int captureWidth = 0;               // 카메라에 요청할 해상도 (0 이면 드라이버 기본값)
+    int captureHeight = 0;
+    double captureFps = 0.0;            // 카메라에 요청할 프레임 속도 (0 이면 드라이버 기본값)
+    int captureBuffers = 0;             // 드라이버 버퍼 개수 (0 이면 드라이버 기본값, 작을수록 지연이 짧음)
+};
+
+// HOG 계산 정밀도
+enum class HOGPrecision {
+    Float,   // 정규화된 float 그래디언트 크기와 atan 근사로 계산 (기존 결과와 동일)
+    Integer, // 그래디언트 크기 제곱을 정수 임계값과 비교하고 방향도 정수 연산으로 구간화
+    Lookup   // 정수 임계값 + 팔분면 접기와 기울기 비율 LUT 로 방향 구간화 (atan/sqrt/나눗셈 없음)
+};
+
+// computeHOG 출력 범위
+enum class HOGOutput {
+    Full,         // 히스토그램 + 시각화용 프레임 크기 float 디버그 영상
+    HistogramOnly // 히스토그램만 (디버그 영상은 만들지 않고 결과에서 해제)
 };
 
 // HOG 파라미터 구조체
@@ -25,6 +83,34 @@ struct HOGParams {
     int blurKernelSize = 11;
     double blurSigma = 3.0;
     int erodeKernelSize = 3;
+    BlurBackend blurBackend = BlurBackend::Gaussian;  // 격자 샘플링 (samplingStride > 1) 은 항상 가우시안 사용
+    HOGPrecision precision = HOGPrecision::Float;
+    int samplingStride = 1;             // 그래디언트를 계산할 격자 간격 (1이면 모든 픽셀)
+    
+    // 2단계 히스토그램 (samplingStride 가 1일 때만 적용)
+    // 거친 빈으로 피크 구간을 찾은 뒤, 같은 패스에서 모아 둔 빈 값으로 그 주변 창만 원래 해상도로 집계
+    // (histogram 은 창 밖이 0, 거친 히스토그램은 HOGResult::coarseHistogram)
+    int coarseBinWidth = 1;             // 거친 빈 너비 (빈 단위, 1 이하이면 사용 안 함)
+    int refineRadius = 10;              // 거친 피크 구간 양옆으로 더 집계할 빈 수
+    int refineBegin = 30;               // 거친 피크를 찾는 빈 범위 [refineBegin, refineEnd) (VVEstimator 각도 범위)
+    int refineEnd = 151;
+    
+    // 시간적 증분 모드 (고정 카메라용, samplingStride 가 1일 때만 적용)
+    // 이전 프레임과 달라진 타일과 그 halo 만 다시 계산하고, 나머지 타일은 이전 부분 히스토그램을 재사용
+    bool temporal = false;
+    double changeThreshold = 2.0;       // 타일 변경 판정 기준 (축소 휘도의 샘플당 평균 절대 차이)
+    double thresholdDrift = 0.01;       // 크기 임계값이 이 비율보다 많이 변하면 전체 타일 재계산
+    
+    // 관심 영역 (비어 있으면 프레임 전체)
+    // 사각형 목록의 합집합과 마스크(0이 아닌 픽셀)의 교집합만 히스토그램과 임계값 범위에 사용
+    std::vector<cv::Rect> roiRects;     // computeHOG 입력 영상 좌표
+    cv::Mat roiMask;                    // CV_8UC1, 입력 영상과 크기가 다르면 최근접 보간으로 맞춤
+};
+
+// 추정에 사용한 프레임의 수신 정보 (VVResult 에 기록)
+struct FrameTiming {
+    double ageMs = 0.0;           // 프레임을 디코딩한 뒤 추정까지 걸린 시간 (ms)
+    int droppedFrames = 0;        // 이 프레임 직전에 버려진 프레임 수
 };
 
 // VV 추정 결과 구조체
@@ -33,6 +119,11 @@ struct VVResult {
     double angleRad = M_PI / 2.0; // 수직 방향 각도 (라디안)
     double accX = 0.0;            // X방향 가속도 (m/s^2)
     double accY = 9.8;            // Y방향 가속도 (m/s^2)
+    bool measured = true;         // false 이면 적응형 건너뛰기로 이전 추정을 이어서 사용한 프레임
+    int level = 0;                // 추정에 사용한 다중 해상도 단계 (pyrDown 횟수, 0 이면 입력 해상도)
+    double confidence = 0.0;      // 히스토그램 피크 선명도 (0 ~ 1)
+    double frameAgeMs = 0.0;      // 프레임을 디코딩한 뒤 추정까지 걸린 시간 (ms)
+    int droppedFrames = 0;        // 최신 프레임 모드에서 이 프레임 직전에 버려진 프레임 수
     
     // 각도에서 가속도 계산 메서드
     void updateAcceleration() {
@@ -43,10 +134,13 @@ struct VVResult {
 };
 
 // HOG 계산 결과 구조체
+// 디버그 영상(gradientX/Y, magnitude, magnitudeFiltered)은 HOGOutput::Full 일 때만 채워짐
 struct HOGResult {
     cv::Mat gradientX;
     cv::Mat gradientY;
     std::vector<float> histogram;
+    std::vector<float> coarseHistogram; // 2단계 히스토그램의 거친 단계 (사용하지 않으면 비어 있음)
+    int coarseBinWidth = 0;             // coarseHistogram 의 빈 너비 (도, 사용하지 않으면 0)
     cv::Mat magnitude;
     cv::Mat magnitudeFiltered;
 };
@@ -3,6 +3,7 @@
 #include <vector>
 #include <opencv2/core.hpp>
 #include "visual_vertical/Types.hpp"
+#include "visual_vertical/ResultStore.hpp"
 
 namespace vv {
 
@@ -15,45 +16,152 @@ class VVEstimator {
 public:
     /**
      * @brief 생성자
+     * @param resultCapacity 결과 버퍼 용량
+     * @param drain 버퍼가 가득 찰 때 결과를 넘겨받을 콜백 (비어 있으면 최근 결과만 유지)
      */
-    VVEstimator();
+    explicit VVEstimator(size_t resultCapacity = 1024, ResultStore::DrainCallback drain = nullptr);
 
     /**
      * @brief HOG 히스토그램에서 VV 각도 추정
      * @param hogHistogram HOG 히스토그램
      * @param previousResult 이전 프레임의 VV 결과 (스무딩을 위해 사용)
+     * @param level 히스토그램을 계산한 다중 해상도 단계 (결과에 기록)
+     * @param timing 추정에 사용한 프레임의 나이와 직전에 버려진 프레임 수 (결과에 기록)
      * @return 추정된 VV 결과
      */
-    VVResult estimateVV(const std::vector<float>& hogHistogram, const VVResult& previousResult);
+    VVResult estimateVV(const std::vector<float>& hogHistogram, const VVResult& previousResult, int level = 0,
+                        const FrameTiming& timing = FrameTiming());
 
     /**
-     * @brief 모든 VV 결과 얻기
-     * @return 지금까지 계산된 모든 VV 결과 벡터
+     * @brief HOG 결과에서 VV 각도 추정 (2단계 히스토그램이면 신뢰도는 거친 히스토그램으로 계산)
+     * @param hogResult HOG 계산 결과
+     * @param previousResult 이전 프레임의 VV 결과 (스무딩을 위해 사용)
+     * @param level 히스토그램을 계산한 다중 해상도 단계 (결과에 기록)
+     * @param timing 추정에 사용한 프레임의 나이와 직전에 버려진 프레임 수 (결과에 기록)
+     * @return 추정된 VV 결과
+     */
+    VVResult estimateVV(const HOGResult& hogResult, const VVResult& previousResult, int level = 0,
+                        const FrameTiming& timing = FrameTiming());
+
+    /**
+     * @brief 히스토그램 피크 선명도 계산
+     *
+     * MIN_ANGLE ~ MAX_ANGLE 범위의 전체 가중치 중 최대 빈 주변 ±PEAK_WINDOW 도에 모인 비율입니다.
+     * 고르게 퍼진 히스토그램은 0 에 가깝고, 한 방향에 몰린 히스토그램은 1 에 가깝습니다.
+     *
+     * @param hogHistogram HOG 히스토그램
+     * @param binWidth 빈 하나의 너비 (도, 거친 히스토그램이면 거친 빈 너비)
+     * @return 신뢰도 (0 ~ 1, 범위 안의 가중치가 없으면 0)
+     */
+    static double peakConfidence(const std::vector<float>& hogHistogram, int binWidth = 1);
+
+    /**
+     * @brief HOG 결과의 피크 선명도 계산
+     *
+     * 2단계 히스토그램이면 세밀한 히스토그램은 피크 주변 창 밖이 0 이라 선명도가 부풀려지므로
+     * 전체 범위를 담은 거친 히스토그램으로 계산합니다.
+     *
+     * @param hogResult HOG 계산 결과
+     * @return 신뢰도 (0 ~ 1)
+     */
+    static double peakConfidence(const HOGResult& hogResult);
+
+    /**
+     * @brief 측정하지 않은 프레임에 이전 추정을 이어서 사용
+     * @param previousResult 이전 프레임의 VV 결과
+     * @param timing 이어서 쓰는 추정의 나이 (측정한 프레임의 나이 + 추정 이후 경과 시간) 와
+     *               건너뛴 프레임 직전에 버려진 프레임 수 (결과에 기록)
+     * @return measured 가 false 인 이전 결과 복사본 (결과 버퍼에도 기록됨)
+     */
+    VVResult carryForward(const VVResult& previousResult, const FrameTiming& timing = FrameTiming());
+
+    /**
+     * @brief 아직 비움 콜백에 넘기지 않은 (또는 최근) VV 결과 얻기
+     * @return 결과 버퍼
+     */
+    const ResultStore& getResults() const;
+
+    /**
+     * @brief 버퍼에 남은 결과를 비움 콜백에 넘기기 (종료 시 호출)
      */
-    const std::vector<VVResult>& getAllResults() const;
+    void flushResults();
 
     /**
      * @brief 히스토그램 시각화 이미지 생성
+     *
+     * 눈금, 레이블, 30/150도 경계선은 캔버스 크기마다 한 번만 그려 두고,
+     * 프레임마다 높이가 바뀐 막대와 VV 표시선 주변 열만 다시 그립니다.
+     *
      * @param hogHistogram HOG 히스토그램
      * @param vvResult 현재 VV 결과
      * @param width 이미지 너비
      * @param height 이미지 높이
-     * @return 히스토그램 시각화 이미지
+     * @return 히스토그램 시각화 이미지 (내부 버퍼를 공유하므로 다음 호출 전까지만 유효)
      */
     cv::Mat createHistogramVisualization(
         const std::vector<float>& hogHistogram,
         const VVResult& vvResult,
         int width,
         int height
-    ) const;
+    );
 
 private:
-    std::vector<VVResult> m_results; // 모든 프레임의 VV 결과 저장
+    // 프레임 간에 재사용하는 히스토그램 시각화 캔버스
+    struct HistogramCanvas {
+        cv::Size size;                 // 캔버스 크기 (바뀌면 정적 레이어를 다시 그림)
+        int bins = 0;                  // 히스토그램 빈 개수 (막대 너비와 눈금 위치를 결정)
+        cv::Mat staticLayer;           // 흰 배경 + 경계선/눈금/레이블
+        cv::Mat staticMask;            // 정적 레이어에서 배경이 아닌 픽셀 (막대 위에 다시 덮음)
+        cv::Mat canvas;                // 반환하는 결과 영상
+        std::vector<int> barHeights;   // 캔버스에 그려진 막대 높이
+        int markerX = 0;               // 캔버스에 그려진 VV 표시선 위치
+        bool hasMarker = false;        // VV 표시선이 그려져 있는지
+        bool canvasValid = false;      // canvas 가 정적 레이어 + barHeights 막대 상태인지
+    };
+
+    /**
+     * @brief 캔버스 크기나 빈 개수가 바뀌면 정적 레이어를 다시 그리고, 캔버스가 무효이면 막대 없이 초기화
+     * @param width 캔버스 너비
+     * @param height 캔버스 높이
+     * @param bins 히스토그램 빈 개수
+     */
+    void prepareHistogramCanvas(int width, int height, int bins);
+
+    /**
+     * @brief 정적 레이어 (경계선/눈금/레이블) 와 그 마스크 그리기
+     * @param width 캔버스 너비
+     * @param height 캔버스 높이
+     * @param bins 히스토그램 빈 개수
+     */
+    void drawHistogramStaticLayer(int width, int height, int bins);
+
+    /**
+     * @brief 캔버스의 [x0, x1) 열을 정적 레이어와 현재 막대 높이로 다시 그림
+     * @param x0 첫 열
+     * @param x1 마지막 열 다음
+     */
+    void repaintHistogramColumns(int x0, int x1);
+
+    /**
+     * @brief 막대 너비 (캔버스 너비와 빈 개수로 결정)
+     */
+    int histogramBarWidth() const;
+
+    /**
+     * @brief 히스토그램에서 VV 각도 추정 (신뢰도는 호출자가 계산)
+     */
+    VVResult estimateFromHistogram(const std::vector<float>& hogHistogram, const VVResult& previousResult, int level,
+                                   const FrameTiming& timing, double confidence);
+
+    HistogramCanvas m_hist;
+    ResultStore m_results; // 고정 용량 VV 결과 버퍼
     
     // 히스토그램 분석을 위한 상수
-    const int MIN_ANGLE = 30;
-    const int MAX_ANGLE = 150;
-    const double SMOOTHING_FACTOR = 0.7; // 이전 각도의 가중치 (0.7 * 현재 + 0.3 * 이전)
+    static constexpr int MIN_ANGLE = 30;
+    static constexpr int MAX_ANGLE = 150;
+    static constexpr int PEAK_COUNT = 3;            // 가중 평균에 사용하는 피크 개수
+    static constexpr int PEAK_WINDOW = 5;           // 피크 선명도 계산 시 최대 빈 주변 반경
+    static constexpr double SMOOTHING_FACTOR = 0.7; // 이전 각도의 가중치 (0.7 * 현재 + 0.3 * 이전)
 };
 
 } // namespace vv 
\ No newline at end of file
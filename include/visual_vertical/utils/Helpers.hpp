@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <string>
 #include <chrono>
 #include <ctime>
@@ -37,7 +38,7 @@ std::string getCurrentDateString();
 void printUsage();
 
 /**
- * @brief OpenCV 정보 및 OpenCL 지원 여부 출력
+ * @brief OpenCV 정보, OpenCL 지원 여부 및 HOG 커널 SIMD 수준 출력
  */
 void printOpenCVInfo();
 
@@ -62,6 +63,36 @@ int argmax(const std::vector<T>& vec, int startIdx, int endIdx);
 template<typename T>
 std::vector<int> argmaxN(const std::vector<T>& vec, int n, int startIdx, int endIdx);
 
+/**
+ * @brief 힙 할당 없이 [startIdx, endIdx) 범위의 상위 n개 인덱스 찾기
+ *
+ * 범위의 인덱스 목록에 std::partial_sort (값 내림차순) 를 적용한 결과와 순서까지 같습니다.
+ * 값이 같은 후보 중 무엇이 남는지는 partial_sort 의 힙 선택 순서를 따르므로,
+ * libstdc++ 의 heap-select 와 sort-heap 단계를 n 칸짜리 힙 위에서 그대로 재현합니다.
+ * @param values 값 배열
+ * @param startIdx 시작 인덱스
+ * @param endIdx 종료 인덱스 (포함하지 않음)
+ * @param indices 상위 인덱스를 받을 배열 (n 칸, 앞쪽 반환값 개수만 유효)
+ * @param n 찾을 상위 개수
+ * @return 찾은 인덱스 개수 (범위 길이가 n보다 작으면 범위 길이)
+ */
+template<typename T>
+int selectTopN(const T* values, int startIdx, int endIdx, int* indices, int n);
+
+/**
+ * @brief 힙 할당 없이 [startIdx, endIdx) 범위의 상위 N개 인덱스 찾기
+ * 
+ * 한 번의 순차 탐색으로 std::array 안의 N 칸 힙만 갱신하며, 결과는 selectTopN 과 같습니다
+ * (값 내림차순, 같은 값의 선택은 std::partial_sort 와 동일).
+ * @param values 값 배열
+ * @param startIdx 시작 인덱스
+ * @param endIdx 종료 인덱스 (포함하지 않음)
+ * @param indices 상위 인덱스를 받을 배열 (앞쪽 반환값 개수만 유효)
+ * @return 찾은 인덱스 개수 (범위 길이가 N보다 작으면 범위 길이)
+ */
+template<int N, typename T>
+int argmaxTopN(const T* values, int startIdx, int endIdx, std::array<int, N>& indices);
+
 } // namespace utils
 } // namespace vv
 
@@ -82,13 +113,83 @@ std::vector<int> vv::utils::argmaxN(const std::vector<T>& vec, int n, int startI
         return {};
     }
     
-    std::vector<int> indices(endIdx - startIdx);
-    std::iota(indices.begin(), indices.end(), startIdx);
+    // 결과 크기만 할당하고 범위 전체의 인덱스 목록은 만들지 않음
+    std::vector<int> indices(std::min(n, endIdx - startIdx));
+    selectTopN(vec.data(), startIdx, endIdx, indices.data(), static_cast<int>(indices.size()));
+    return indices;
+}
+
+namespace vv {
+namespace utils {
+namespace detail {
+
+// libstdc++ 의 __adjust_heap: 구멍 holeIndex 에서 큰 자식을 끌어올린 뒤 value 를 위로 밀어 넣음
+// (비교 comp(a, b) = values[a] > values[b] 이므로 힙의 맨 위는 가장 작은 값)
+template<typename T>
+void adjustTopHeap(const T* values, int* heap, int holeIndex, int len, int value) {
+    auto comp = [values](int a, int b) { return values[a] > values[b]; };
+    const int topIndex = holeIndex;
+    int secondChild = holeIndex;
+    while (secondChild < (len - 1) / 2) {
+        secondChild = 2 * (secondChild + 1);
+        if (comp(heap[secondChild], heap[secondChild - 1])) {
+            secondChild--;
+        }
+        heap[holeIndex] = heap[secondChild];
+        holeIndex = secondChild;
+    }
+    if ((len & 1) == 0 && secondChild == (len - 2) / 2) {
+        secondChild = 2 * (secondChild + 1);
+        heap[holeIndex] = heap[secondChild - 1];
+        holeIndex = secondChild - 1;
+    }
+    int parent = (holeIndex - 1) / 2;
+    while (holeIndex > topIndex && comp(heap[parent], value)) {
+        heap[holeIndex] = heap[parent];
+        holeIndex = parent;
+        parent = (holeIndex - 1) / 2;
+    }
+    heap[holeIndex] = value;
+}
+
+} // namespace detail
+} // namespace utils
+} // namespace vv
+
+template<typename T>
+int vv::utils::selectTopN(const T* values, int startIdx, int endIdx, int* indices, int n) {
+    const int len = std::min(n, endIdx - startIdx);
+    if (len <= 0) {
+        return 0;
+    }
     
-    std::partial_sort(indices.begin(), indices.begin() + std::min(n, static_cast<int>(indices.size())), 
-                     indices.end(),
-                     [&vec](int i1, int i2) { return vec[i1] > vec[i2]; });
+    // heap-select: 앞쪽 len 개로 힙을 만들고, 맨 위 (가장 작은 값) 보다 큰 값만 맨 위와 교체
+    for (int i = 0; i < len; i++) {
+        indices[i] = startIdx + i;
+    }
+    if (len > 1) {
+        for (int parent = (len - 2) / 2; parent >= 0; parent--) {
+            detail::adjustTopHeap(values, indices, parent, len, indices[parent]);
+        }
+    }
+    for (int i = startIdx + len; i < endIdx; i++) {
+        // 대부분의 빈은 여기서 걸러짐
+        if (values[i] > values[indices[0]]) {
+            detail::adjustTopHeap(values, indices, 0, len, i);
+        }
+    }
     
-    indices.resize(std::min(n, static_cast<int>(indices.size())));
-    return indices;
-} 
\ No newline at end of file
+    // sort-heap: 맨 위를 끝으로 보내며 값 내림차순으로 정렬
+    for (int last = len - 1; last > 0; last--) {
+        const int value = indices[last];
+        indices[last] = indices[0];
+        detail::adjustTopHeap(values, indices, 0, last, value);
+    }
+    return len;
+}
+
+template<int N, typename T>
+int vv::utils::argmaxTopN(const T* values, int startIdx, int endIdx, std::array<int, N>& indices) {
+    static_assert(N > 0, "argmaxTopN requires N > 0");
+    return selectTopN(values, startIdx, endIdx, indices.data(), N);
+}
@@ -0,0 +1,216 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <opencv2/core.hpp>
+#include <opencv2/videoio.hpp>
+
+#include "visual_vertical/ImageProcessor.hpp"
+#include "visual_vertical/HOGKernel.hpp"
+#include "visual_vertical/VVEstimator.hpp"
+
+namespace {
+
+// 벤치마크 설정
+struct BenchmarkConfig {
+    std::string inputFilePath = "./test.mp4";
+    int scale = 2;
+    int maxFrames = 300;
+    std::vector<int> strides = { 2, 3, 4 };
+    std::vector<int> blurSizes = { 11, 21, 31 };
+    std::vector<std::string> simdLevels;  // 기본 설정과 비교할 SIMD 변형
+};
+
+// 비교할 HOG 설정 하나와 그 누적 측정값
+struct Variant {
+    std::string name;
+    size_t reference;  // 각도 오차의 기준이 되는 설정 인덱스
+    vv::ImageProcessor processor;
+    vv::VVEstimator estimator;
+    vv::HOGResult hogResult;
+    vv::VVResult previousResult;
+    double totalMs = 0.0;
+    double sumError = 0.0;
+    double maxError = 0.0;
+
+    Variant(const std::string& variantName, const vv::HOGParams& params, size_t referenceIndex = 0)
+        : name(variantName), reference(referenceIndex), processor(params) {}
+};
+
+void printUsage() {
+    std::cout << "Visual Vertical HOG Benchmark\n"
+              << "-----------------------------\n"
+              << "Usage:\n"
+              << "  vv_benchmark -i <inputfile> [options]\n\n"
+              << "Options:\n"
+              << "  -h, --help               Show this help message\n"
+              << "  -i, --inputfile <path>   Recording to benchmark\n"
+              << "  -s, --scale <n>          Image scaling factor (default: 2)\n"
+              << "  -n, --frames <n>         Maximum number of frames (default: 300)\n"
+              << "  --strides <list>         Comma separated sampling strides (default: 2,3,4)\n"
+              << "  --blur-sizes <list>      Comma separated blur kernel sizes for Gaussian vs box blur (default: 11,21,31)\n"
+              << "  --simd <list>            Comma separated HOG kernel SIMD levels to compare (scalar,sse4.2,avx2,avx512)\n"
+              << std::endl;
+}
+
+std::vector<int> parseIntList(const std::string& text) {
+    std::vector<int> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        try {
+            values.push_back(std::stoi(item));
+        } catch (const std::exception&) {
+            std::cerr << "Warning: Ignoring invalid value '" << item << "'" << std::endl;
+        }
+    }
+    return values;
+}
+
+BenchmarkConfig parseArgs(int argc, char* argv[]) {
+    BenchmarkConfig config;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            printUsage();
+            exit(0);
+        }
+        else if ((arg == "-i" || arg == "--inputfile") && i + 1 < argc) {
+            config.inputFilePath = argv[++i];
+        }
+        else if ((arg == "-s" || arg == "--scale") && i + 1 < argc) {
+            config.scale = std::max(1, std::stoi(argv[++i]));
+        }
+        else if ((arg == "-n" || arg == "--frames") && i + 1 < argc) {
+            config.maxFrames = std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--strides" && i + 1 < argc) {
+            config.strides = parseIntList(argv[++i]);
+        }
+        else if (arg == "--blur-sizes" && i + 1 < argc) {
+            config.blurSizes = parseIntList(argv[++i]);
+        }
+        else if (arg == "--simd" && i + 1 < argc) {
+            std::stringstream ss(argv[++i]);
+            std::string item;
+            while (std::getline(ss, item, ',')) {
+                config.simdLevels.push_back(item);
+            }
+        }
+    }
+    return config;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchmarkConfig config = parseArgs(argc, argv);
+
+    cv::VideoCapture capture(config.inputFilePath);
+    if (!capture.isOpened()) {
+        std::cerr << "Error: Could not open " << config.inputFilePath << std::endl;
+        return 1;
+    }
+
+    // 첫 번째 설정(전체 샘플링)이 각도 오차의 기준
+    std::vector<Variant> variants;
+    variants.reserve(config.strides.size() + 2 * config.blurSizes.size() + config.simdLevels.size() + 2);
+    variants.emplace_back("full", vv::HOGParams());
+    vv::HOGParams temporalParams;
+    temporalParams.temporal = true;
+    variants.emplace_back("temporal", temporalParams);
+    for (int stride : config.strides) {
+        if (stride <= 1) {
+            continue;
+        }
+        vv::HOGParams params;
+        params.samplingStride = stride;
+        variants.emplace_back("stride " + std::to_string(stride), params);
+    }
+    
+    // 커널 크기별 가우시안/상자 블러 (sigma 는 기본 설정의 크기 대비 비율 유지, 상자 블러는 같은 크기의 가우시안이 기준)
+    const vv::HOGParams defaults;
+    for (int size : config.blurSizes) {
+        if (size < 3) {
+            continue;
+        }
+        vv::HOGParams params;
+        params.blurKernelSize = size | 1;
+        params.blurSigma = defaults.blurSigma * params.blurKernelSize / defaults.blurKernelSize;
+        size_t reference = 0;
+        if (params.blurKernelSize != defaults.blurKernelSize) {
+            reference = variants.size();
+            variants.emplace_back("gauss " + std::to_string(params.blurKernelSize), params, reference);
+        }
+        params.blurBackend = vv::BlurBackend::Box;
+        variants.emplace_back("box " + std::to_string(params.blurKernelSize), params, reference);
+    }
+    
+    // SIMD 변형별 기본 설정 (커널은 ImageProcessor 생성 시점의 수준으로 고정됨)
+    const vv::kernel::SimdLevel activeLevel = vv::kernel::activeSimdLevel();
+    for (const std::string& name : config.simdLevels) {
+        vv::kernel::SimdLevel level;
+        if (!vv::kernel::parseSimdLevel(name.c_str(), level)) {
+            std::cerr << "Warning: Ignoring unknown SIMD level '" << name << "'" << std::endl;
+            continue;
+        }
+        if (!vv::kernel::setSimdLevel(level)) {
+            std::cerr << "Warning: Skipping SIMD level " << name << " (not supported by this CPU)" << std::endl;
+            continue;
+        }
+        variants.emplace_back(std::string("simd ") + vv::kernel::simdLevelName(level), vv::HOGParams());
+    }
+    vv::kernel::setSimdLevel(activeLevel);
+
+    vv::ImageProcessor resizer;
+    cv::Mat rawFrame, frame;
+    int frameCount = 0;
+    while (frameCount < config.maxFrames && capture.read(rawFrame)) {
+        resizer.resizeImage(rawFrame, config.scale, frame);
+
+        for (Variant& variant : variants) {
+            auto start = std::chrono::steady_clock::now();
+            variant.processor.computeHOG(frame, variant.hogResult, vv::HOGOutput::HistogramOnly);
+            auto end = std::chrono::steady_clock::now();
+            variant.totalMs += std::chrono::duration<double, std::milli>(end - start).count();
+
+            variant.previousResult = variant.estimator.estimateVV(variant.hogResult, variant.previousResult);
+        }
+
+        for (Variant& variant : variants) {
+            double reference = variants[variant.reference].previousResult.angle;
+            double error = std::abs(variant.previousResult.angle - reference);
+            variant.sumError += error;
+            variant.maxError = std::max(variant.maxError, error);
+        }
+        frameCount++;
+    }
+
+    if (frameCount == 0) {
+        std::cerr << "Error: No frames read from " << config.inputFilePath << std::endl;
+        return 1;
+    }
+
+    std::cout << "Frames: " << frameCount << " (" << frame.cols << "x" << frame.rows << "), HOG SIMD: "
+              << vv::kernel::simdLevelName(activeLevel) << std::endl;
+    std::cout << std::left << std::setw(12) << "variant"
+              << std::right << std::setw(12) << "ms/frame"
+              << std::setw(10) << "fps"
+              << std::setw(14) << "mean err(deg)"
+              << std::setw(14) << "max err(deg)" << std::endl;
+    for (const Variant& variant : variants) {
+        double msPerFrame = variant.totalMs / frameCount;
+        std::cout << std::left << std::setw(12) << variant.name
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << msPerFrame
+                  << std::setw(10) << (msPerFrame > 0.0 ? 1000.0 / msPerFrame : 0.0)
+                  << std::setw(14) << variant.sumError / frameCount
+                  << std::setw(14) << variant.maxError << std::endl;
+    }
+
+    return 0;
+}
@@ -1,21 +1,36 @@
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <memory>
 #include <opencv2/core.hpp>
 #include <opencv2/highgui.hpp>
 #include <opencv2/imgproc.hpp>
+#include <opencv2/imgcodecs.hpp>
 
 #include "visual_vertical/ImageProcessor.hpp"
 #include "visual_vertical/VVEstimator.hpp"
 #include "visual_vertical/IOHandler.hpp"
+#include "visual_vertical/AdaptiveSkipper.hpp"
+#include "visual_vertical/ScaleCascade.hpp"
+#include "visual_vertical/RenderThread.hpp"
 #include "visual_vertical/utils/Helpers.hpp"
 #include "visual_vertical/fps/FPSCounter.hpp"
 
 int main(int argc, char* argv[]) {
-    // OpenCV 정보 출력
-    vv::utils::printOpenCVInfo();
-    
     // 명령줄 인자 파싱
     vv::Config config = vv::utils::parseCommandLineArgs(argc, argv);
     
+    // HOG 커널 SIMD 수준 지정 (ImageProcessor 생성 전에 적용해야 함)
+    vv::kernel::SimdLevel simdLevel;
+    if (!config.simd.empty() && vv::kernel::parseSimdLevel(config.simd.c_str(), simdLevel)
+        && !vv::kernel::setSimdLevel(simdLevel)) {
+        std::cerr << "Warning: CPU does not support SIMD level " << config.simd << ", using "
+                  << vv::kernel::simdLevelName(vv::kernel::activeSimdLevel()) << std::endl;
+    }
+    
+    // OpenCV 정보 출력
+    vv::utils::printOpenCVInfo();
+    
     // 입출력 핸들러 초기화
     vv::IOHandler ioHandler(config);
     if (!ioHandler.openVideoSource()) {
@@ -23,9 +38,40 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
+    // HOG 관심 영역 설정 (원본 프레임 좌표를 크기 조정된 프레임 좌표로 변환)
+    vv::HOGParams hogParams;
+    hogParams.samplingStride = config.samplingStride;
+    hogParams.temporal = config.temporal;
+    hogParams.blurBackend = config.blurBackend;
+    hogParams.coarseBinWidth = config.coarseBinWidth;
+    for (const cv::Rect& rect : config.roiRects) {
+        hogParams.roiRects.emplace_back(rect.x / config.scale, rect.y / config.scale,
+                                        rect.width / config.scale, rect.height / config.scale);
+    }
+    if (!config.roiMaskPath.empty()) {
+        // 마스크는 computeHOG 에서 프레임 크기에 맞춰 최근접 보간으로 조정됨
+        hogParams.roiMask = cv::imread(config.roiMaskPath, cv::IMREAD_GRAYSCALE);
+        if (hogParams.roiMask.empty()) {
+            std::cerr << "Warning: Could not read ROI mask " << config.roiMaskPath << std::endl;
+        }
+    }
+    
     // 이미지 처리기 및 VV 추정기 초기화
-    vv::ImageProcessor imageProcessor;
-    vv::VVEstimator vvEstimator;
+    vv::ImageProcessor imageProcessor(hogParams);
+    
+    // 다중 해상도 단계가 지정되면 거친 단계부터 신뢰도가 충분할 때까지 계산
+    std::unique_ptr<vv::ScaleCascade> cascade;
+    if (!config.cascadeLevels.empty()) {
+        cascade = std::make_unique<vv::ScaleCascade>(hogParams, config.cascadeLevels, config.cascadeConfidence);
+    }
+    // 결과는 고정 용량 버퍼에 모았다가 가득 찰 때마다 CSV 에 이어서 기록 (장시간 실행에도 메모리 일정)
+    vv::ResultStore::DrainCallback drainResults;
+    if (config.saveResults) {
+        drainResults = [&ioHandler](const vv::VVResult* results, size_t count) {
+            ioHandler.appendResultsToCSV(results, count);
+        };
+    }
+    vv::VVEstimator vvEstimator(config.resultBufferSize, drainResults);
     
     // FPS 카운터 초기화
     vv::FPSCounter fpsCounter;
@@ -36,9 +82,10 @@ int main(int argc, char* argv[]) {
         std::cerr << "Error: Could not read first frame." << std::endl;
         return 1;
     }
+    std::cout << "Startup to first frame: " << ioHandler.getStartupLatencyMs() << " ms" << std::endl;
     
-    // 이미지 크기 조정
-    frame = imageProcessor.resizeImage(frame, config.scale);
+    // 이미지 크기 조정 (원시 YUV 프레임은 Y 평면만 사용)
+    frame = imageProcessor.resizeImage(vv::ImageProcessor::hogInput(frame, ioHandler.getFrameFormat()), config.scale);
     
     // 비디오 작성기 설정
     int originalWidth = frame.cols;
@@ -47,77 +94,210 @@ int main(int argc, char* argv[]) {
     // 결과 비디오 크기 계산 (원본 이미지 * 2 + 히스토그램)
     int resultWidth = originalWidth * 2;
     int resultHeight = static_cast<int>(originalHeight * 2.6);
+    int histogramHeight = static_cast<int>(originalHeight * 0.6);
+    
+    // 녹화 프레임 속도: 입력 프레임 n 개마다 한 장 기록하므로 입력 속도 / n,
+    // --render-fps 가 더 낮으면 그 속도 (벽시계 기준 제한이라 처리가 그보다 느리면 근사값)
+    bool recording = false;
+    if (!config.headless) {
+        double recordFps = ioHandler.getSourceFps() / std::max(1, config.renderEvery);
+        if (config.renderRate > 0.0) {
+            recordFps = std::min(recordFps, config.renderRate);
+        }
+        recording = ioHandler.setupVideoWriter(resultWidth, resultHeight, recordFps);
+        if (!recording) {
+            std::cerr << "Warning: Could not setup video writer." << std::endl;
+        }
+    }
+    
+    // 미리 읽기 (이후 캡처 객체는 디코딩 스레드만 사용하므로 캡처 속성 조회를 마친 뒤 시작)
+    // 최신 프레임 모드는 캡처 스레드가 계속 읽고 처리 루프는 가장 최근 프레임만 사용
+    if (config.readAhead > 0 || config.latestFrame) {
+        const size_t depth = config.readAhead > 0 ? static_cast<size_t>(config.readAhead) : 2;
+        ioHandler.startReadAhead(depth, config.latestFrame);
+    }
     
-    if (!ioHandler.setupVideoWriter(resultWidth, resultHeight)) {
-        std::cerr << "Warning: Could not setup video writer." << std::endl;
+    // 시각화 렌더링 스레드 (추정 루프는 렌더링할 차례인 프레임의 스냅샷만 넘기고, 녹화하지 않으면 기다리지 않음)
+    // 렌더링 전용 처리기와 히스토그램 시각화기를 따로 두어 추정 루프의 객체와 공유하지 않음
+    vv::ImageProcessor renderProcessor;
+    vv::VVEstimator histogramRenderer(1);
+    cv::Mat calibratedImage;
+    std::unique_ptr<vv::RenderThread> renderer;
+    if (!config.headless) {
+        // 녹화 중에는 렌더링이 밀려도 스냅샷을 버리지 않음 (큐가 가득 차면 추정 루프가 기다림)
+        vv::RenderThread::FrameSink recordSink;
+        if (recording) {
+            recordSink = [&](const cv::Mat& canvas) {
+                ioHandler.writeFrame(canvas);
+            };
+        }
+        renderer = std::make_unique<vv::RenderThread>([&](const vv::RenderSnapshot& snapshot) {
+            // 이미지 회전 (보정) - 시각화 캔버스의 보정 패널에 바로 그림
+            calibratedImage = renderProcessor.calibratedPanel(snapshot.frame.size(), histogramHeight);
+            renderProcessor.rotateImage(snapshot.frame, 90 - snapshot.vv.angle, calibratedImage);
+            
+            // 히스토그램 시각화 생성
+            cv::Mat histogramImage = histogramRenderer.createHistogramVisualization(
+                snapshot.hog.histogram,
+                snapshot.vv,
+                resultWidth,
+                histogramHeight
+            );
+            
+            // 시각화 이미지 생성
+            cv::Mat visualizationResult = renderProcessor.createVisualization(
+                snapshot.frame,
+                calibratedImage,
+                snapshot.hog,
+                snapshot.vv,
+                histogramImage,
+                snapshot.fps // FPS 정보 전달
+            );
+            
+            // 저장은 기록 콜백이, 표시는 주 스레드가 합성한 캔버스를 가져가서 함
+            return visualizationResult;
+        }, config.renderRate, config.renderEvery, recordSink);
+        renderer->start();
     }
     
+    // 렌더링 스레드가 새로 합성한 캔버스가 있으면 주 스레드에서 표시 (HighGUI 는 주 스레드 전용)
+    // ESC 키가 눌리면 false
+    cv::Mat displayCanvas;
+    auto displayRendered = [&]() {
+        if (!renderer || !renderer->takeDisplayFrame(displayCanvas)) {
+            return true;
+        }
+        return ioHandler.displayFrame(displayCanvas) != 27;
+    };
+    
     // 이전 VV 결과 초기화
     vv::VVResult previousResult;
     
+    // 프레임 디코딩부터 추정까지의 지연 통계
+    double frameAgeSumMs = 0.0;
+    double frameAgeMaxMs = 0.0;
+    long long estimatedFrames = 0;
+    
+    // 프레임 간에 재사용하는 버퍼 (첫 프레임 이후에는 재할당 없음)
+    cv::Mat rawFrame;
+    vv::HOGResult hogResult;
+    vv::HOGResult renderHogResult; // 렌더링 프레임 전용 (디버그 영상 버퍼를 프레임 간에 유지)
+    
+    // 적응형 프레임 건너뛰기 (장면이 안정적인 동안 디코딩과 HOG 생략)
+    vv::AdaptiveSkipper adaptiveSkipper(config.adaptiveInterval, config.sceneChangeThreshold);
+    
     // 메인 처리 루프
     while (true) {
         // FPS 측정 시작
         fpsCounter.tickStart();
         
+        // 장면이 안정적이면 프레임을 디코딩하지 않고 이전 추정을 이어서 사용
+        if (!adaptiveSkipper.shouldMeasure()) {
+            if (!ioHandler.skipNextFrame()) {
+                break;
+            }
+            adaptiveSkipper.frameSkipped();
+            
+            // 이어서 쓰는 추정의 나이는 측정한 프레임의 디코딩 시각부터, 버려진 프레임 수는 건너뛴 프레임 기준
+            vv::FrameTiming carriedTiming;
+            carriedTiming.ageMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - ioHandler.getFrameTimestamp()).count();
+            carriedTiming.droppedFrames = ioHandler.getDroppedFrames();
+            previousResult = vvEstimator.carryForward(previousResult, carriedTiming);
+            
+            // 녹화 간격을 유지하도록 건너뛴 프레임 자리에는 직전 캔버스를 다시 기록
+            if (renderer && renderer->frameDue()) {
+                renderer->postRepeat();
+            }
+            fpsCounter.tickEnd();
+            if (!displayRendered()) {
+                break;
+            }
+            continue;
+        }
+        
         // 프레임 읽기
-        if (!ioHandler.readNextFrame(frame)) {
+        if (!ioHandler.readNextFrame(rawFrame)) {
             break;
         }
         
-        // 이미지 크기 조정
-        frame = imageProcessor.resizeImage(frame, config.scale);
+        // HOG 입력 준비 (크기 조정이 없으면 원시 프레임을 복사 없이 사용, 렌더링 스냅샷은 따로 복사됨)
+        cv::Mat hogFrame;
+        if (config.scale <= 1) {
+            hogFrame = vv::ImageProcessor::hogInput(rawFrame, ioHandler.getFrameFormat());
+        } else {
+            imageProcessor.resizeImage(vv::ImageProcessor::hogInput(rawFrame, ioHandler.getFrameFormat()),
+                                       config.scale, frame);
+            hogFrame = frame;
+        }
         
-        // HOG 계산
-        vv::HOGResult hogResult = imageProcessor.computeHOG(frame);
+        // HOG 계산 (디버그 영상은 렌더링할 프레임에서만 렌더링 전용 결과에 계산)
+        const bool renderFrame = renderer && renderer->frameDue();
+        const vv::HOGOutput hogOutput = renderFrame ? vv::HOGOutput::Full : vv::HOGOutput::HistogramOnly;
+        vv::HOGResult& frameHog = renderFrame ? renderHogResult : hogResult;
+        int level = 0;
+        if (cascade) {
+            level = cascade->computeHOG(hogFrame, frameHog, hogOutput);
+        } else {
+            imageProcessor.computeHOG(hogFrame, frameHog, hogOutput);
+        }
+        adaptiveSkipper.frameMeasured(hogFrame);
         
-        // VV 추정
-        vv::VVResult vvResult = vvEstimator.estimateVV(hogResult.histogram, previousResult);
+        // VV 추정 (프레임 나이와 직전에 버려진 프레임 수를 함께 기록)
+        vv::FrameTiming timing;
+        timing.ageMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - ioHandler.getFrameTimestamp()).count();
+        timing.droppedFrames = ioHandler.getDroppedFrames();
+        frameAgeSumMs += timing.ageMs;
+        frameAgeMaxMs = std::max(frameAgeMaxMs, timing.ageMs);
+        estimatedFrames++;
+        vv::VVResult vvResult = vvEstimator.estimateVV(frameHog, previousResult, level, timing);
         previousResult = vvResult;
         
-        // 이미지 회전 (보정)
-        cv::Mat calibratedImage = imageProcessor.rotateImage(frame, 90 - vvResult.angle);
-        
-        // 히스토그램 시각화 생성
-        cv::Mat histogramImage = vvEstimator.createHistogramVisualization(
-            hogResult.histogram,
-            vvResult,
-            resultWidth,
-            originalHeight * 0.6
-        );
-        
-        // 시각화 이미지 생성
-        cv::Mat visualizationResult = imageProcessor.createVisualization(
-            frame,
-            calibratedImage,
-            hogResult,
-            vvResult,
-            histogramImage,
-            fpsCounter.getFPS() // FPS 정보 전달
-        );
-        
-        // 결과 표시 및 저장
-        int key = ioHandler.displayFrame(visualizationResult);
-        ioHandler.writeFrame(visualizationResult);
+        // 렌더링할 차례이면 스냅샷을 넘김 (CSV 결과는 렌더링과 무관하게 매 프레임 기록됨)
+        if (renderFrame) {
+            renderer->post(hogFrame, frameHog, vvResult, fpsCounter.getFPS());
+        }
         
         // FPS 측정 종료
         fpsCounter.tickEnd();
         
-        // ESC 키가 눌리면 종료
-        if (key == 27) {
+        // 합성된 캔버스 표시, ESC 키가 눌리면 종료
+        if (!displayRendered()) {
             break;
         }
     }
     
-    // 결과 CSV 저장
+    // 마지막 스냅샷까지 그린 뒤 렌더링 스레드 정지
+    if (renderer) {
+        renderer->stop();
+    }
+    
+    // 미리 읽기 링 점유율 (평균이 용량에 가까우면 처리, 0 에 가까우면 디코딩이 병목)
+    if (const vv::FrameQueue* frameQueue = ioHandler.getFrameQueue()) {
+        std::cout << "Read-ahead queue: mean occupancy " << frameQueue->meanOccupancy() << " / " << frameQueue->depth()
+                  << ", decoder stalls " << frameQueue->producerStalls()
+                  << ", processing stalls " << frameQueue->consumerStalls() << std::endl;
+        if (frameQueue->latestOnly()) {
+            std::cout << "Dropped frames (latest-frame mode): " << frameQueue->droppedFrames() << std::endl;
+        }
+    }
+    ioHandler.stopReadAhead();
+    
+    // 남은 결과 기록 후 CSV 닫기
     if (config.saveResults) {
-        ioHandler.saveResultsToCSV(vvEstimator.getAllResults());
+        vvEstimator.flushResults();
+        ioHandler.closeResultsCSV();
     }
     
     // 평균 FPS 출력
     std::cout << "Average FPS: " << fpsCounter.getAverageFPS() << std::endl;
     std::cout << "Total frames processed: " << fpsCounter.getFrameCount() << std::endl;
     std::cout << "Total processing time: " << fpsCounter.getTotalProcessingTimeSec() << " seconds" << std::endl;
+    if (estimatedFrames > 0) {
+        std::cout << "Capture-to-estimate latency: mean " << frameAgeSumMs / estimatedFrames
+                  << " ms, max " << frameAgeMaxMs << " ms" << std::endl;
+    }
     
     std::cout << "Processing complete." << std::endl;
     return 0;
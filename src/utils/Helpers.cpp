@@ -1,4 +1,5 @@
 #include "visual_vertical/utils/Helpers.hpp"
+#include "visual_vertical/HOGKernel.hpp"
 #include <iostream>
 #include <chrono>
 #include <iomanip>
@@ -10,6 +11,29 @@
 namespace vv {
 namespace utils {
 
+namespace {
+
+// "x,y,w,h" 형식의 사각형 파싱
+bool parseRect(const std::string& text, cv::Rect& rect) {
+    int values[4];
+    std::stringstream ss(text);
+    for (int i = 0; i < 4; i++) {
+        std::string item;
+        if (!std::getline(ss, item, ',')) {
+            return false;
+        }
+        try {
+            values[i] = std::stoi(item);
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    rect = cv::Rect(values[0], values[1], values[2], values[3]);
+    return rect.width > 0 && rect.height > 0;
+}
+
+} // namespace
+
 Config parseCommandLineArgs(int argc, char* argv[]) {
     Config config;
     
@@ -47,6 +71,166 @@ Config parseCommandLineArgs(int argc, char* argv[]) {
                 }
             }
         }
+        else if (arg == "--roi") {
+            if (i + 1 < argc) {
+                cv::Rect rect;
+                if (parseRect(argv[++i], rect)) {
+                    config.roiRects.push_back(rect);
+                } else {
+                    std::cerr << "Warning: Ignoring invalid ROI '" << argv[i] << "' (expected x,y,w,h)" << std::endl;
+                }
+            }
+        }
+        else if (arg == "--stride") {
+            if (i + 1 < argc) {
+                config.samplingStride = std::max(1, std::stoi(argv[++i]));
+            }
+        }
+        else if (arg == "--temporal") {
+            if (i + 1 < argc) {
+                std::string value = argv[++i];
+                config.temporal = (value == "true" || value == "1");
+            }
+        }
+        else if (arg == "--headless") {
+            if (i + 1 < argc) {
+                std::string value = argv[++i];
+                config.headless = (value == "true" || value == "1");
+            }
+        }
+        else if (arg == "--simd") {
+            if (i + 1 < argc) {
+                std::string value = argv[++i];
+                kernel::SimdLevel level;
+                if (kernel::parseSimdLevel(value.c_str(), level)) {
+                    config.simd = value;
+                } else {
+                    std::cerr << "Warning: Ignoring unknown SIMD level '" << value << "' (expected scalar, sse4.2, avx2 or avx512)" << std::endl;
+                }
+            }
+        }
+        else if (arg == "--blur") {
+            if (i + 1 < argc) {
+                std::string value = argv[++i];
+                if (value == "box") {
+                    config.blurBackend = BlurBackend::Box;
+                } else if (value == "gaussian") {
+                    config.blurBackend = BlurBackend::Gaussian;
+                } else {
+                    std::cerr << "Warning: Ignoring unknown blur backend '" << value << "' (expected gaussian or box)" << std::endl;
+                }
+            }
+        }
+        else if (arg == "--result-buffer") {
+            if (i + 1 < argc) {
+                config.resultBufferSize = std::max(1, std::stoi(argv[++i]));
+            }
+        }
+        else if (arg == "--adaptive") {
+            if (i + 1 < argc) {
+                config.adaptiveInterval = std::max(0, std::stoi(argv[++i]));
+            }
+        }
+        else if (arg == "--scene-threshold") {
+            if (i + 1 < argc) {
+                config.sceneChangeThreshold = std::max(0.0, std::stod(argv[++i]));
+            }
+        }
+        else if (arg == "--coarse-bins") {
+            if (i + 1 < argc) {
+                config.coarseBinWidth = std::max(1, std::stoi(argv[++i]));
+            }
+        }
+        else if (arg == "--cascade") {
+            if (i + 1 < argc) {
+                config.cascadeLevels.clear();
+                std::stringstream ss(argv[++i]);
+                std::string item;
+                while (std::getline(ss, item, ',')) {
+                    try {
+                        config.cascadeLevels.push_back(std::max(0, std::stoi(item)));
+                    } catch (const std::exception&) {
+                        std::cerr << "Warning: Ignoring invalid cascade level '" << item << "'" << std::endl;
+                    }
+                }
+            }
+        }
+        else if (arg == "--cascade-confidence") {
+            if (i + 1 < argc) {
+                config.cascadeConfidence = std::stod(argv[++i]);
+            }
+        }
+        else if (arg == "--render-fps") {
+            if (i + 1 < argc) {
+                config.renderRate = std::max(0.0, std::stod(argv[++i]));
+            }
+        }
+        else if (arg == "--render-every") {
+            if (i + 1 < argc) {
+                config.renderEvery = std::max(1, std::stoi(argv[++i]));
+            }
+        }
+        else if (arg == "--read-ahead") {
+            if (i + 1 < argc) {
+                config.readAhead = std::max(0, std::stoi(argv[++i]));
+            }
+        }
+        else if (arg == "--latest-frame") {
+            if (i + 1 < argc) {
+                std::string value = argv[++i];
+                config.latestFrame = (value == "true" || value == "1");
+            }
+        }
+        else if (arg == "--capture-backend") {
+            if (i + 1 < argc) {
+                std::string value = argv[++i];
+                if (value == "auto") {
+                    config.captureBackend = CaptureBackend::Auto;
+                } else if (value == "v4l2") {
+                    config.captureBackend = CaptureBackend::V4L2;
+                } else if (value == "dshow") {
+                    config.captureBackend = CaptureBackend::DShow;
+                } else if (value == "msmf") {
+                    config.captureBackend = CaptureBackend::MSMF;
+                } else {
+                    std::cerr << "Warning: Ignoring unknown capture backend '" << value << "' (expected auto, v4l2, dshow or msmf)" << std::endl;
+                }
+            }
+        }
+        else if (arg == "--capture-format") {
+            if (i + 1 < argc) {
+                config.captureFourcc = argv[++i];
+            }
+        }
+        else if (arg == "--capture-size") {
+            if (i + 1 < argc) {
+                std::string value = argv[++i];
+                int width = 0, height = 0;
+                char separator = 0;
+                std::stringstream ss(value);
+                if (ss >> width >> separator >> height && (separator == 'x' || separator == 'X') && width > 0 && height > 0) {
+                    config.captureWidth = width;
+                    config.captureHeight = height;
+                } else {
+                    std::cerr << "Warning: Ignoring invalid capture size '" << value << "' (expected WxH)" << std::endl;
+                }
+            }
+        }
+        else if (arg == "--capture-fps") {
+            if (i + 1 < argc) {
+                config.captureFps = std::max(0.0, std::stod(argv[++i]));
+            }
+        }
+        else if (arg == "--capture-buffers") {
+            if (i + 1 < argc) {
+                config.captureBuffers = std::max(0, std::stoi(argv[++i]));
+            }
+        }
+        else if (arg == "--roi-mask") {
+            if (i + 1 < argc) {
+                config.roiMaskPath = argv[++i];
+            }
+        }
     }
     
     return config;
@@ -84,10 +268,34 @@ void printUsage() {
               << "  -i, --inputfile <path>   Specify input video file path\n"
               << "  -c, --camera <bool>      Use camera as input source (true/false)\n"
               << "  -cp, --camera_port <n>   Specify camera port number (default: 0)\n"
-              << "  -s, --scale <n>          Image scaling factor (default: 2)\n\n"
+              << "  -s, --scale <n>          Image scaling factor (default: 2)\n"
+              << "  --roi <x,y,w,h>          Restrict HOG to a rectangle in input frame pixels (repeatable)\n"
+              << "  --roi-mask <path>        Restrict HOG to non-zero pixels of a grayscale mask image\n"
+              << "  --stride <n>             Evaluate HOG gradients every n-th pixel in each direction (default: 1)\n"
+              << "  --temporal <bool>        Recompute only tiles that changed since the previous frame (true/false)\n"
+              << "  --blur <gaussian|box>    Blur backend; box approximates the Gaussian at constant cost (default: gaussian)\n"
+              << "  --headless <bool>        Estimate VV only, without display or video; reads raw luma when supported\n"
+              << "  --simd <level>           Force HOG kernel variant: scalar, sse4.2, avx2 or avx512 (default: best supported, or VV_SIMD)\n"
+              << "  --result-buffer <n>      Results kept in memory before being appended to the CSV (default: 1024)\n"
+              << "  --adaptive <n>           Skip decoding and HOG while the scene is stable, measuring at least every n frames (default: off)\n"
+              << "  --scene-threshold <v>    Mean absolute thumbnail luma difference that counts as a scene change (default: 2.0)\n"
+              << "  --coarse-bins <n>        Find the peak on n-degree bins, then count 1-degree bins only around it (default: 1, off)\n"
+              << "  --cascade <list>         Pyramid levels (pyrDown count) tried coarse to fine, e.g. 2,0 (default: off)\n"
+              << "  --cascade-confidence <v> Peak sharpness (0-1) at which a cascade level is accepted (default: 0.25)\n"
+              << "  --render-fps <hz>        Cap visualization rendering at this rate (default: 0, no cap)\n"
+              << "  --render-every <n>       Render every n-th input frame; recorded at source fps / n (default: 1)\n"
+              << "  --read-ahead <n>         Decode up to n frames ahead on a separate thread (default: 0, off)\n"
+              << "  --latest-frame <bool>    Keep grabbing on a capture thread and always process the newest frame (true/false)\n"
+              << "  --capture-backend <api>  Camera backend: auto, v4l2, dshow or msmf (default: auto)\n"
+              << "  --capture-format <code>  Camera pixel format FOURCC, e.g. YUYV, MJPG or GREY (default: driver)\n"
+              << "  --capture-size <WxH>     Camera resolution (default: driver)\n"
+              << "  --capture-fps <n>        Camera frame rate (default: driver)\n"
+              << "  --capture-buffers <n>    Camera driver buffer count; fewer means lower latency (default: driver)\n\n"
               << "Examples:\n"
               << "  vv_estimator -i ./test.mp4 --scale 2\n"
               << "  vv_estimator --camera true --camera_port 0 --scale 1\n"
+              << "  vv_estimator -i ./test.mp4 --roi 0,0,1920,720\n"
+              << "  vv_estimator -c true --capture-backend v4l2 --capture-format YUYV --capture-buffers 2 --latest-frame true\n"
               << std::endl;
 }
 
@@ -106,6 +314,10 @@ void printOpenCVInfo() {
         std::cout << "OpenCL Device: " << device.name() << std::endl;
         std::cout << "Vendor: " << device.vendorName() << std::endl;
     }
+    
+    // HOG 행 커널 SIMD 변형
+    std::cout << "HOG SIMD: " << kernel::simdLevelName(kernel::activeSimdLevel())
+              << " (detected: " << kernel::simdLevelName(kernel::detectSimdLevel()) << ")" << std::endl;
 }
 
 } // namespace utils
@@ -0,0 +1,57 @@
+#include "visual_vertical/AdaptiveSkipper.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace vv {
+
+AdaptiveSkipper::AdaptiveSkipper(int maxInterval, double changeThreshold)
+    : m_maxInterval(maxInterval), m_changeThreshold(changeThreshold) {
+    m_thumb.reserve(THUMB_COLS * THUMB_ROWS);
+    m_current.reserve(THUMB_COLS * THUMB_ROWS);
+}
+
+bool AdaptiveSkipper::shouldMeasure() const {
+    return m_maxInterval <= 1 || m_skipped >= m_interval;
+}
+
+void AdaptiveSkipper::frameSkipped() {
+    m_skipped++;
+}
+
+bool AdaptiveSkipper::frameMeasured(const cv::Mat& image) {
+    m_skipped = 0;
+    if (m_maxInterval <= 1 || image.empty() || image.depth() != CV_8U) {
+        m_interval = 0;
+        return true;
+    }
+
+    // 고정 격자 샘플의 축소 휘도 (그레이 입력은 그대로, BGR 은 (B + 2G + R) / 4)
+    const int channels = image.channels();
+    const int cols = std::min(THUMB_COLS, image.cols);
+    const int rows = std::min(THUMB_ROWS, image.rows);
+    m_current.resize(static_cast<size_t>(cols) * rows);
+    size_t i = 0;
+    for (int ty = 0; ty < rows; ty++) {
+        const uchar* src = image.ptr<uchar>(ty * image.rows / rows);
+        for (int tx = 0; tx < cols; tx++, i++) {
+            const uchar* p = src + static_cast<size_t>(tx * image.cols / cols) * channels;
+            m_current[i] = (channels == 1) ? p[0] : static_cast<uint8_t>((p[0] + 2 * p[1] + p[2]) >> 2);
+        }
+    }
+
+    bool changed = true;
+    if (m_thumb.size() == m_current.size()) {
+        long long sad = 0;
+        for (size_t j = 0; j < m_current.size(); j++) {
+            sad += std::abs(static_cast<int>(m_current[j]) - static_cast<int>(m_thumb[j]));
+        }
+        changed = sad > m_changeThreshold * static_cast<double>(m_current.size());
+    }
+    m_thumb.swap(m_current);
+
+    // 안정적이면 건너뛰는 프레임 수를 1, 3, 7, ... 로 늘리고 (측정 간격 2배), 변하면 매 프레임 측정
+    m_interval = changed ? 0 : std::min(2 * m_interval + 1, m_maxInterval - 1);
+    return changed;
+}
+
+} // namespace vv
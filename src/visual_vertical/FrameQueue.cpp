@@ -0,0 +1,120 @@
+#include "visual_vertical/FrameQueue.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace vv {
+
+FrameQueue::FrameQueue(size_t depth, bool latestOnly)
+    : m_slots(std::max<size_t>(1, depth)), m_latestOnly(latestOnly) {
+}
+
+cv::Mat* FrameQueue::beginWrite() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_latestOnly && m_count == m_slots.size()) {
+        // 기다리지 않고 가장 오래된 프레임을 버림 (채울 슬롯 위치 m_head + m_count 는 그대로)
+        m_head = (m_head + 1) % m_slots.size();
+        m_count--;
+        m_dropped++;
+        m_droppedPending++;
+    }
+    if (m_count == m_slots.size() && !m_shutdown) {
+        m_producerStalls++;
+        m_notFull.wait(lock, [this] { return m_count < m_slots.size() || m_shutdown; });
+    }
+    if (m_shutdown) {
+        return nullptr;
+    }
+    // 대기 중이 아닌 슬롯은 소비자가 건드리지 않으므로 잠금 밖에서 채워도 됨
+    return &m_slots[(m_head + m_count) % m_slots.size()].frame;
+}
+
+void FrameQueue::commitWrite(PixelFormat format) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Slot& slot = m_slots[(m_head + m_count) % m_slots.size()];
+        slot.format = format;
+        slot.timestamp = Clock::now();
+        m_count++;
+    }
+    m_notEmpty.notify_one();
+}
+
+void FrameQueue::close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+    }
+    m_notEmpty.notify_all();
+}
+
+void FrameQueue::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_notFull.notify_all();
+    m_notEmpty.notify_all();
+}
+
+bool FrameQueue::pop(cv::Mat& frame, FrameInfo& info) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_count == 0 && !m_closed && !m_shutdown) {
+        m_consumerStalls++;
+        m_notEmpty.wait(lock, [this] { return m_count > 0 || m_closed || m_shutdown; });
+    }
+    if (m_count == 0 || m_shutdown) {
+        return false;
+    }
+
+    m_occupancySum += static_cast<long long>(m_count);
+    m_pops++;
+
+    // 최신 프레임 모드: 가장 최근 프레임 앞의 프레임은 모두 버림
+    if (m_latestOnly && m_count > 1) {
+        const size_t skipped = m_count - 1;
+        m_head = (m_head + skipped) % m_slots.size();
+        m_count = 1;
+        m_dropped += static_cast<long long>(skipped);
+        m_droppedPending += static_cast<int>(skipped);
+    }
+
+    // 슬롯과 버퍼를 교환 (호출자의 이전 버퍼는 다음 디코딩에 재사용)
+    Slot& slot = m_slots[m_head];
+    std::swap(frame, slot.frame);
+    info.format = slot.format;
+    info.timestamp = slot.timestamp;
+    info.droppedBefore = m_droppedPending;
+    m_droppedPending = 0;
+    m_head = (m_head + 1) % m_slots.size();
+    m_count--;
+    lock.unlock();
+    m_notFull.notify_one();
+    return true;
+}
+
+size_t FrameQueue::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_count;
+}
+
+double FrameQueue::meanOccupancy() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pops > 0 ? static_cast<double>(m_occupancySum) / static_cast<double>(m_pops) : 0.0;
+}
+
+long long FrameQueue::droppedFrames() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dropped;
+}
+
+long long FrameQueue::producerStalls() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_producerStalls;
+}
+
+long long FrameQueue::consumerStalls() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_consumerStalls;
+}
+
+} // namespace vv
@@ -0,0 +1,1000 @@
+#include "visual_vertical/HOGKernel.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// x86 GCC/Clang 빌드는 행 커널을 ISA 별로 다시 컴파일해 두고 CPUID 로 고름
+// (float 경로가 모든 변형에서 같은 결과를 내도록 FMA 는 켜지 않음)
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VV_SIMD_MULTIVERSION 1
+#define VV_ALWAYS_INLINE inline __attribute__((always_inline))
+#define VV_TARGET(isa) __attribute__((target(isa)))
+#if defined(__clang__)
+#define VV_AVX512_TARGET "avx512f,avx512bw,avx512vl,avx512dq"
+#else
+#define VV_AVX512_TARGET "avx512f,avx512bw,avx512vl,avx512dq,prefer-vector-width=512"
+#endif
+#else
+#define VV_SIMD_MULTIVERSION 0
+#define VV_ALWAYS_INLINE inline
+#endif
+
+namespace vv {
+namespace kernel {
+
+namespace {
+
+// 1도 간격 빈 경계 방향의 단위 벡터 (1 << 14 배율)
+struct BinBoundaryTable {
+    int32_t cosTab[180];
+    int32_t sinTab[180];
+    
+    BinBoundaryTable() {
+        for (int b = 0; b < 180; b++) {
+            double rad = b * 3.14159265358979323846 / 180.0;
+            cosTab[b] = static_cast<int32_t>(std::lround(std::cos(rad) * (1 << 14)));
+            sinTab[b] = static_cast<int32_t>(std::lround(std::sin(rad) * (1 << 14)));
+        }
+    }
+};
+
+// 네임스페이스 범위 객체로 두어 SIMD 변형에서 출력 행과 겹치지 않음을 컴파일러가 알 수 있게 함 (테이블 조회 벡터화)
+const BinBoundaryTable BIN_BOUNDARIES;
+
+// 첫 팔분면 기울기 비율 -> 각도 테이블
+constexpr int RATIO_BITS = 12;
+constexpr int ANGLE_SCALE = 256; // 1/256도 단위
+
+struct RatioLutTable {
+    uint64_t recip[MAX_SOBEL_GRADIENT + 1];  // ceil(2^32 / m)
+    uint16_t angle[(1 << RATIO_BITS) + 1];   // atan(i / 2^RATIO_BITS), 구간 하한 기준
+    
+    RatioLutTable() {
+        recip[0] = 0;
+        for (int m = 1; m <= MAX_SOBEL_GRADIENT; m++) {
+            recip[m] = ((1ull << 32) + m - 1) / m;
+        }
+        // 구간 하한 값을 쓰므로 비율 0 (축 방향)과 1 (대각선)은 정확히 0도, 45도
+        for (int i = 0; i <= (1 << RATIO_BITS); i++) {
+            double deg = std::atan(static_cast<double>(i) / (1 << RATIO_BITS)) * 180.0 / 3.14159265358979323846;
+            angle[i] = static_cast<uint16_t>(std::lround(deg * ANGLE_SCALE));
+        }
+    }
+};
+
+const RatioLutTable RATIO_LUT;
+
+inline int binInt(const BinBoundaryTable& table, int gx, int gy) {
+    // 위쪽 반평면 [0, 180) 으로 접기 (180도 방향은 0번 빈)
+    // 벡터화되도록 비교 대신 부호 비트 연산으로 작성: flip = gy < 0 || (gy == 0 && gx < 0)
+    const int flip = (gy >> 31) | ((gx >> 31) & ~((gy | -gy) >> 31));
+    gx = (gx ^ flip) - flip;
+    gy = (gy ^ flip) - flip;
+    
+    // 각도 >= b  <=>  cross(u_b, g) = cos(b) * gy - sin(b) * gx >= 0
+    // 고정 횟수 이진 탐색 (128 + 64 + ... + 1, 179 를 넘는 후보는 건너뜀), 반복문 없이 펼쳐 둠
+    int lo = 0;
+    auto probe = [&](int step) {
+        const int mid = lo + step;
+        const int b = std::min(mid, 179);
+        const int fail = ((table.cosTab[b] * gy - table.sinTab[b] * gx) >> 31) | ((179 - mid) >> 31);
+        lo += step & ~fail;
+    };
+    probe(128);
+    probe(64);
+    probe(32);
+    probe(16);
+    probe(8);
+    probe(4);
+    probe(2);
+    probe(1);
+    return lo;
+}
+
+inline int lutBin(const RatioLutTable& table, int gx, int gy) {
+    int ax = gx < 0 ? -gx : gx;
+    int ay = gy < 0 ? -gy : gy;
+    int mn = std::min(ax, ay);
+    int mx = std::max(ax, ay);
+    
+    // mn / mx 를 [0, 2^RATIO_BITS] 로 양자화 (mx == 0 이면 역수가 0 이므로 0도)
+    uint32_t idx = static_cast<uint32_t>((mn * table.recip[mx]) >> (32 - RATIO_BITS));
+    int a = table.angle[idx];
+    
+    // 팔분면 되돌리기 (분기 예측 실패를 피하도록 조건부 선택으로 작성)
+    a = (ay > ax) ? 90 * ANGLE_SCALE - a : a;
+    a = (gx < 0) ? 180 * ANGLE_SCALE - a : a;
+    a = (gy < 0) ? 360 * ANGLE_SCALE - a : a;
+    a = (a >= 180 * ANGLE_SCALE) ? a - 180 * ANGLE_SCALE : a;
+    a = (a >= 180 * ANGLE_SCALE) ? 0 : a; // 360도
+    return a / ANGLE_SCALE;
+}
+
+} // namespace
+
+int orientationBinLut(int gx, int gy) {
+    return lutBin(RATIO_LUT, gx, gy);
+}
+
+int orientationBinInt(int gx, int gy) {
+    return binInt(BIN_BOUNDARIES, gx, gy);
+}
+
+namespace {
+
+// SIMD 변형마다 다시 컴파일하는 행 커널 본문
+// (대상 ISA 함수 안으로 강제 인라인되어 그 ISA 로 자동 벡터화되므로, 내부 루프는 분기 없이 작성)
+
+VV_ALWAYS_INLINE void sobelRowBody(const uint8_t* up, const uint8_t* cur, const uint8_t* down, int cols,
+                                   int xBegin, int xEnd, int16_t* gx, int16_t* gy) {
+    if (xBegin >= xEnd) {
+        return;
+    }
+    if (cols == 1) {
+        // 한 열짜리 영상은 좌우 이웃이 자기 자신이므로 x 그래디언트는 0
+        gx[0] = 0;
+        gy[0] = static_cast<int16_t>(4 * (up[0] - down[0]));
+        return;
+    }
+    
+    // 좌우 경계는 BORDER_REFLECT_101 (x = -1 -> 1, x = cols -> cols - 2)
+    auto pixel = [&](int x, int l, int r) {
+        int dx = (up[r] + 2 * cur[r] + down[r]) - (up[l] + 2 * cur[l] + down[l]);
+        int dy = (down[l] + 2 * down[x] + down[r]) - (up[l] + 2 * up[x] + up[r]);
+        gx[x] = static_cast<int16_t>(dx);
+        gy[x] = static_cast<int16_t>(-dy); // y 방향 반전 (위쪽이 양수)
+    };
+    const int midBegin = std::max(xBegin, 1);
+    const int midEnd = std::min(xEnd, cols - 1);
+    if (xBegin == 0) {
+        pixel(0, 1, 1);
+    }
+    for (int x = midBegin; x < midEnd; x++) {
+        pixel(x, x - 1, x + 1);
+    }
+    if (xEnd == cols) {
+        pixel(cols - 1, cols - 2, cols - 2);
+    }
+}
+
+// 정규화 크기 임계값을 크기 제곱의 정수 임계값으로 변환
+// sqrt, 상수 빼기, 음이 아닌 상수 곱하기는 모두 단조이므로 통과 여부는 크기 제곱에 대한 계단 함수이고,
+// 그 경계를 이진 탐색으로 찾으면 float 식과 비트 단위로 같은 판정을 정수 비교로 할 수 있음
+inline bool floatPass(int32_t m2, float magMin, float invRange, float threshold) {
+    float mag = std::sqrt(static_cast<float>(m2));
+    return (mag - magMin) * invRange > threshold;
+}
+
+inline int32_t floatThresholdSq(float magMin, float invRange, float threshold) {
+    int64_t lo = -1;                          // 통과하지 않는 가장 큰 값 후보
+    int64_t hi = 2 * 32768LL * 32768LL;       // int16 그래디언트의 크기 제곱 상한 (통과 여부 미정)
+    if (!floatPass(static_cast<int32_t>(std::min<int64_t>(hi, INT32_MAX)), magMin, invRange, threshold)) {
+        return INT32_MAX;
+    }
+    while (hi - lo > 1) {
+        int64_t mid = lo + (hi - lo) / 2;
+        if (floatPass(static_cast<int32_t>(std::min<int64_t>(mid, INT32_MAX)), magMin, invRange, threshold)) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+    return static_cast<int32_t>(lo);
+}
+
+// Dense 이면 통과 여부와 무관하게 모든 픽셀의 방향 빈을 계산한 뒤 조건부 선택으로 골라 분기 없이 벡터화하고,
+// 아니면 (스칼라 변형) 통과한 픽셀만 방향을 계산
+template <bool Dense>
+VV_ALWAYS_INLINE void thresholdRowBody(const int16_t* gx, const int16_t* gy, int cols,
+                                       float magMin, float invRange, float threshold,
+                                       uint8_t* __restrict mask, uint8_t* __restrict bins) {
+    if (Dense && invRange >= 0.0f) {
+        // 행마다 한 번 정수 임계값을 구해 sqrt 없이 판정 (invRange 가 음수/NaN 이면 단조성이 없으므로 제외)
+        const int32_t thresholdSq = floatThresholdSq(magMin, invRange, threshold);
+        for (int x = 0; x < cols; x++) {
+            int32_t m2 = gx[x] * gx[x] + gy[x] * gy[x];
+            uint8_t pass = (m2 > thresholdSq) ? 1 : 0;
+            mask[x] = pass;
+            // 선택식 대신 마스크 곱으로 골라야 방향 계산이 조건부 블록으로 내려가지 않음
+            uint8_t bin = static_cast<uint8_t>(orientationBin(gx[x], gy[x]));
+            bins[x] = static_cast<uint8_t>(bin & (0 - pass));
+        }
+        return;
+    }
+    for (int x = 0; x < cols; x++) {
+        float mag = std::sqrt(static_cast<float>(gx[x] * gx[x] + gy[x] * gy[x]));
+        uint8_t pass = ((mag - magMin) * invRange > threshold) ? 1 : 0;
+        mask[x] = pass;
+        // 방향은 임계값을 통과한 픽셀만 필요 (침식 결과는 항상 mask 의 부분집합)
+        bins[x] = pass ? static_cast<uint8_t>(orientationBin(gx[x], gy[x])) : 0;
+    }
+}
+
+template <bool Dense>
+VV_ALWAYS_INLINE void thresholdRowIntBody(const int16_t* gx, const int16_t* gy, int cols, int32_t thresholdSq,
+                                          uint8_t* __restrict mask, uint8_t* __restrict bins) {
+    const BinBoundaryTable& table = BIN_BOUNDARIES;
+    for (int x = 0; x < cols; x++) {
+        int32_t m2 = gx[x] * gx[x] + gy[x] * gy[x];
+        uint8_t pass = (m2 > thresholdSq) ? 1 : 0;
+        mask[x] = pass;
+        if (Dense) {
+            uint8_t bin = static_cast<uint8_t>(binInt(table, gx[x], gy[x]));
+            bins[x] = static_cast<uint8_t>(bin & (0 - pass));
+        } else {
+            bins[x] = pass ? static_cast<uint8_t>(binInt(table, gx[x], gy[x])) : 0;
+        }
+    }
+}
+
+// LUT 경로는 64비트 역수 테이블 조회가 벡터화되지 않으므로 모든 변형에서 통과한 픽셀만 방향을 계산
+VV_ALWAYS_INLINE void thresholdRowLutBody(const int16_t* gx, const int16_t* gy, int cols, int32_t thresholdSq,
+                                          uint8_t* __restrict mask, uint8_t* __restrict bins) {
+    const RatioLutTable& table = RATIO_LUT;
+    for (int x = 0; x < cols; x++) {
+        int32_t m2 = gx[x] * gx[x] + gy[x] * gy[x];
+        uint8_t pass = (m2 > thresholdSq) ? 1 : 0;
+        mask[x] = pass;
+        bins[x] = pass ? static_cast<uint8_t>(lutBin(table, gx[x], gy[x])) : 0;
+    }
+}
+
+// 가장 낮은 설정 비트의 위치 (word != 0)
+inline int lowestBit(uint64_t word) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+// 비트 마스크 침식 본문 (특화 커널은 left/right 를 상수로 넘겨 이동 루프를 펼침)
+VV_ALWAYS_INLINE void erodeBitsBody(const uint64_t* const* rows, int rowCount, int cols, int xBegin, int xEnd,
+                                    int left, int right, uint64_t* tmp, uint64_t* out) {
+    if (xBegin >= xEnd) {
+        return;
+    }
+    const int w0 = xBegin / MASK_WORD_BITS;
+    const int w1 = (xEnd + MASK_WORD_BITS - 1) / MASK_WORD_BITS;
+    const int t0 = std::max(0, xBegin - left) / MASK_WORD_BITS;
+    const int t1 = std::min(maskWords(cols), (xEnd + right + MASK_WORD_BITS - 1) / MASK_WORD_BITS);
+    
+    // 세로 방향 AND (가로 창이 닿는 워드까지)
+    std::copy(rows[0] + t0, rows[0] + t1, tmp + t0);
+    for (int i = 1; i < rowCount; i++) {
+        const uint64_t* row = rows[i];
+        for (int w = t0; w < t1; w++) {
+            tmp[w] &= row[w];
+        }
+    }
+    
+    // 가로 방향 AND: 비트 i 에 픽셀 64w + i + d 가 오도록 이동한 워드들의 AND
+    // (계산하지 않은 워드와 영상 밖 워드는 1 로 보고, 그 영향은 범위 밖 비트에만 미침)
+    auto at = [&](int w) { return (w >= t0 && w < t1) ? tmp[w] : ~0ull; };
+    for (int w = w0; w < w1; w++) {
+        uint64_t v = ~0ull;
+        for (int d = -left; d <= right; d++) {
+            // d = 64 * wordShift + r (0 <= r < 64)
+            const int wordShift = (d >= 0) ? d / MASK_WORD_BITS : -((MASK_WORD_BITS - 1 - d) / MASK_WORD_BITS);
+            const int r = d - wordShift * MASK_WORD_BITS;
+            const int q = w + wordShift;
+            v &= (r == 0) ? at(q) : (at(q) >> r) | (at(q + 1) << (MASK_WORD_BITS - r));
+        }
+        out[w] = v;
+    }
+}
+
+} // namespace
+
+void bgrToGrayRow(const uint8_t* src, int cols, int channels, uint8_t* dst) {
+    // Y = 0.299 R + 0.587 G + 0.114 B (1 << 14 배율)
+    const int B2Y = 1868, G2Y = 9617, R2Y = 4899;
+    for (int x = 0; x < cols; x++, src += channels) {
+        dst[x] = static_cast<uint8_t>((src[0] * B2Y + src[1] * G2Y + src[2] * R2Y + (1 << 13)) >> 14);
+    }
+}
+
+std::vector<uint16_t> gaussianKernelFixedPoint(int ksize, double sigma) {
+    if (ksize <= 1) {
+        return std::vector<uint16_t>(1, 256);
+    }
+    ksize |= 1; // 대칭 커널만 지원 (cv::GaussianBlur 도 홀수 크기만 허용)
+    if (sigma <= 0) {
+        // cv::getGaussianKernel 의 작은 커널 고정 테이블 (256 배율)
+        switch (ksize) {
+            case 3: return { 64, 128, 64 };
+            case 5: return { 16, 64, 96, 64, 16 };
+            case 7: return { 8, 28, 56, 72, 56, 28, 8 };
+            default: break;
+        }
+        sigma = 0.3 * ((ksize - 1) * 0.5 - 1) + 0.8;
+    }
+    
+    std::vector<double> values(ksize);
+    double sum = 0.0;
+    double center = (ksize - 1) * 0.5;
+    for (int i = 0; i < ksize; i++) {
+        double x = i - center;
+        values[i] = std::exp(-(x * x) / (2.0 * sigma * sigma));
+        sum += values[i];
+    }
+    
+    // 양쪽 계수를 오차 확산으로 반올림하고 중심 계수로 합을 256에 맞춤
+    std::vector<uint16_t> taps(ksize);
+    int half = ksize / 2;
+    double err = 0.0;
+    int tapSum = 0;
+    for (int i = 0; i < half; i++) {
+        double v = values[i] / sum * 256.0 + err;
+        int q = static_cast<int>(std::nearbyint(v));
+        err = v - q;
+        taps[i] = taps[ksize - 1 - i] = static_cast<uint16_t>(q);
+        tapSum += 2 * q;
+    }
+    taps[half] = static_cast<uint16_t>(256 - tapSum);
+    return taps;
+}
+
+void blurRowH(const uint8_t* src, int cols, int xBegin, int xEnd, const uint16_t* taps, int ksize, uint16_t* dst) {
+    const int r = ksize / 2;
+    for (int x = xBegin; x < xEnd; x++) {
+        uint32_t acc = 0;
+        if (x >= r && x + r < cols) {
+            const uint8_t* s = src + x - r;
+            for (int i = 0; i < ksize; i++) {
+                acc += taps[i] * s[i];
+            }
+        } else {
+            for (int i = 0; i < ksize; i++) {
+                acc += taps[i] * src[reflect101(x - r + i, cols)];
+            }
+        }
+        dst[x] = static_cast<uint16_t>(acc);
+    }
+}
+
+void blurRowV(const uint16_t* const* rows, int cols, const uint16_t* taps, int ksize, uint8_t* dst) {
+    for (int x = 0; x < cols; x++) {
+        uint32_t acc = 0;
+        for (int i = 0; i < ksize; i++) {
+            acc += static_cast<uint32_t>(taps[i]) * rows[i][x];
+        }
+        dst[x] = static_cast<uint8_t>((acc + (1u << 15)) >> 16);
+    }
+}
+
+std::vector<int> boxBlurRadii(int ksize, double sigma, int passes) {
+    passes = std::max(1, passes);
+    if (sigma <= 0) {
+        sigma = 0.3 * ((std::max(ksize, 1) - 1) * 0.5 - 1) + 0.8;
+    }
+    
+    // 폭 wl, wu = wl + 2 인 상자를 섞어 분산 합 (w^2 - 1) / 12 을 sigma^2 에 맞춤
+    const double var12 = 12.0 * sigma * sigma;
+    int wl = static_cast<int>(std::floor(std::sqrt(var12 / passes + 1.0)));
+    if (wl % 2 == 0) {
+        wl--;
+    }
+    wl = std::max(1, wl);
+    const double mIdeal = (var12 - passes * wl * wl - 4.0 * passes * wl - 3.0 * passes) / (-4.0 * wl - 4.0);
+    const int m = std::clamp(static_cast<int>(std::lround(mIdeal)), 0, passes);
+    
+    std::vector<int> radii(passes);
+    for (int i = 0; i < passes; i++) {
+        int width = (i < m) ? wl : wl + 2;
+        radii[i] = width / 2;
+    }
+    return radii;
+}
+
+namespace {
+
+// 상자 폭 나눗셈용 32비트 소수부 역수
+inline uint64_t boxReciprocal(int radius) {
+    const uint64_t width = 2 * static_cast<uint64_t>(radius) + 1;
+    return ((1ull << 32) + width / 2) / width;
+}
+
+// 입력 배율 scale (8비트 입력이면 256, 고정소수점 입력이면 1) 을 곱해 평균을 8비트 소수부로 맞춤
+template <typename T>
+void boxRowHImpl(const T* src, int cols, int xBegin, int xEnd, int radius, uint64_t scale, uint16_t* dst) {
+    if (xBegin >= xEnd) {
+        return;
+    }
+    const uint64_t mul = boxReciprocal(radius) * scale;
+    uint32_t acc = 0;
+    for (int i = -radius; i <= radius; i++) {
+        acc += src[reflect101(xBegin + i, cols)];
+    }
+    for (int x = xBegin; x < xEnd; x++) {
+        dst[x] = static_cast<uint16_t>((acc * mul + (1ull << 31)) >> 32);
+        if (x + 1 < xEnd) {
+            int add = x + radius + 1;
+            int sub = x - radius;
+            acc += src[add < cols ? add : reflect101(add, cols)];
+            acc -= src[sub >= 0 ? sub : reflect101(sub, cols)];
+        }
+    }
+}
+
+} // namespace
+
+void boxRowH(const uint8_t* src, int cols, int xBegin, int xEnd, int radius, uint16_t* dst) {
+    boxRowHImpl(src, cols, xBegin, xEnd, radius, 256, dst);
+}
+
+void boxRowH(const uint16_t* src, int cols, int xBegin, int xEnd, int radius, uint16_t* dst) {
+    boxRowHImpl(src, cols, xBegin, xEnd, radius, 1, dst);
+}
+
+void boxAddRow(const uint16_t* src, int cols, uint32_t* acc) {
+    for (int x = 0; x < cols; x++) {
+        acc[x] += src[x];
+    }
+}
+
+void boxSubRow(const uint16_t* src, int cols, uint32_t* acc) {
+    for (int x = 0; x < cols; x++) {
+        acc[x] -= src[x];
+    }
+}
+
+void boxAverageRow(const uint32_t* acc, int cols, int radius, uint16_t* dst) {
+    const uint64_t mul = boxReciprocal(radius);
+    for (int x = 0; x < cols; x++) {
+        dst[x] = static_cast<uint16_t>((acc[x] * mul + (1ull << 31)) >> 32);
+    }
+}
+
+void boxAverageRow8(const uint32_t* acc, int cols, int radius, uint8_t* dst) {
+    // 평균 (8비트 소수부) 을 반올림해 정수부만 남김
+    const uint64_t mul = boxReciprocal(radius);
+    for (int x = 0; x < cols; x++) {
+        dst[x] = static_cast<uint8_t>((acc[x] * mul + (1ull << 39)) >> 40);
+    }
+}
+
+void sobelRow(const uint8_t* up, const uint8_t* cur, const uint8_t* down, int cols, int xBegin, int xEnd,
+              int16_t* gx, int16_t* gy) {
+    sobelRowBody(up, cur, down, cols, xBegin, xEnd, gx, gy);
+}
+
+void sobelGaussianTaps(const uint16_t* taps, int ksize, int32_t* smooth, int32_t* deriv) {
+    // 블러 후 Sobel 을 적용하는 상관(correlation) 두 번은 계수의 합성곱 한 번과 같음
+    const int smoothKernel[3] = { 1, 2, 1 };
+    const int derivKernel[3] = { -1, 0, 1 };
+    std::fill(smooth, smooth + ksize + 2, 0);
+    std::fill(deriv, deriv + ksize + 2, 0);
+    for (int j = 0; j < ksize; j++) {
+        for (int m = 0; m < 3; m++) {
+            smooth[j + m] += smoothKernel[m] * taps[j];
+            deriv[j + m] += derivKernel[m] * taps[j];
+        }
+    }
+}
+
+void verticalDerivativeRow(const uint8_t* const* rows, int xBegin, int xEnd,
+                           const int32_t* smooth, const int32_t* deriv, int ksize,
+                           int32_t* outSmooth, int32_t* outDeriv) {
+    // 평활 계수는 대칭, 미분 계수는 반대칭이므로 위아래 행 쌍의 합과 차로 곱셈을 절반으로 줄임
+    const int half = ksize / 2;
+    const uint8_t* center = rows[half];
+    for (int x = xBegin; x < xEnd; x++) {
+        outSmooth[x] = smooth[half] * center[x];
+        outDeriv[x] = 0;
+    }
+    for (int i = 0; i < half; i++) {
+        const uint8_t* up = rows[i];
+        const uint8_t* down = rows[ksize - 1 - i];
+        const int32_t s = smooth[i];
+        const int32_t d = deriv[ksize - 1 - i];
+        for (int x = xBegin; x < xEnd; x++) {
+            outSmooth[x] += s * (up[x] + down[x]);
+            outDeriv[x] += d * (down[x] - up[x]);
+        }
+    }
+}
+
+void latticeGradientRow(const int32_t* vSmooth, const int32_t* vDeriv, int cols, int stride,
+                        int lxBegin, int lxEnd, const int32_t* smooth, const int32_t* deriv, int ksize,
+                        int16_t* gx, int16_t* gy) {
+    const int r = ksize / 2;
+    for (int lx = lxBegin; lx < lxEnd; lx++) {
+        const int x = lx * stride;
+        int32_t dx = 0, dy = 0;
+        if (x >= r && x + r < cols) {
+            const int32_t* vs = vSmooth + x - r;
+            const int32_t* vd = vDeriv + x - r;
+            for (int j = 0; j < ksize; j++) {
+                dx += deriv[j] * vs[j];
+                dy += smooth[j] * vd[j];
+            }
+        } else {
+            for (int j = 0; j < ksize; j++) {
+                int xi = reflect101(x - r + j, cols);
+                dx += deriv[j] * vSmooth[xi];
+                dy += smooth[j] * vDeriv[xi];
+            }
+        }
+        // 가우시안 계수 배율 (256 * 256) 제거
+        gx[lx] = static_cast<int16_t>((dx + (1 << 15)) >> 16);
+        gy[lx] = static_cast<int16_t>(-((dy + (1 << 15)) >> 16)); // y 방향 반전 (위쪽이 양수)
+    }
+}
+
+void magnitudeRange(const int16_t* gx, const int16_t* gy, int cols, int32_t& minSq, int32_t& maxSq) {
+    int32_t lo = minSq;
+    int32_t hi = maxSq;
+    for (int x = 0; x < cols; x++) {
+        int32_t m2 = gx[x] * gx[x] + gy[x] * gy[x];
+        lo = std::min(lo, m2);
+        hi = std::max(hi, m2);
+    }
+    minSq = lo;
+    maxSq = hi;
+}
+
+void magnitudeRangeMasked(const int16_t* gx, const int16_t* gy, const uint8_t* select, int cols,
+                          int32_t& minSq, int32_t& maxSq) {
+    int32_t lo = minSq;
+    int32_t hi = maxSq;
+    for (int x = 0; x < cols; x++) {
+        if (select[x]) {
+            int32_t m2 = gx[x] * gx[x] + gy[x] * gy[x];
+            lo = std::min(lo, m2);
+            hi = std::max(hi, m2);
+        }
+    }
+    minSq = lo;
+    maxSq = hi;
+}
+
+void thresholdRow(const int16_t* gx, const int16_t* gy, int cols,
+                  float magMin, float invRange, float threshold,
+                  uint8_t* mask, uint8_t* bins) {
+    thresholdRowBody<false>(gx, gy, cols, magMin, invRange, threshold, mask, bins);
+}
+
+void thresholdRowInt(const int16_t* gx, const int16_t* gy, int cols, int32_t thresholdSq,
+                     uint8_t* mask, uint8_t* bins) {
+    thresholdRowIntBody<false>(gx, gy, cols, thresholdSq, mask, bins);
+}
+
+void thresholdRowLut(const int16_t* gx, const int16_t* gy, int cols, int32_t thresholdSq,
+                     uint8_t* mask, uint8_t* bins) {
+    thresholdRowLutBody(gx, gy, cols, thresholdSq, mask, bins);
+}
+
+void erodeRow(const uint8_t* const* rows, int rowCount, int cols, int xBegin, int xEnd, int ksize,
+              uint8_t* tmp, uint8_t* out) {
+    if (xBegin >= xEnd) {
+        return;
+    }
+    
+    // getStructuringElement 기본 앵커는 ksize / 2
+    int left = ksize / 2;
+    int right = ksize - 1 - left;
+    int t0 = std::max(0, xBegin - left);
+    int t1 = std::min(cols, xEnd + right);
+    
+    // 세로 방향 AND (가로 창이 닿는 열까지)
+    std::copy(rows[0] + t0, rows[0] + t1, tmp + t0);
+    for (int i = 1; i < rowCount; i++) {
+        const uint8_t* row = rows[i];
+        for (int x = t0; x < t1; x++) {
+            tmp[x] &= row[x];
+        }
+    }
+
+    // 가로 방향 AND
+    for (int x = xBegin; x < xEnd; x++) {
+        int x0 = std::max(0, x - left);
+        int x1 = std::min(cols - 1, x + right);
+        uint8_t v = 1;
+        for (int i = x0; i <= x1; i++) {
+            v &= tmp[i];
+        }
+        out[x] = v;
+    }
+}
+
+void packMaskRow(const uint8_t* mask, int cols, int xBegin, int xEnd, uint64_t* bits) {
+    if (xBegin >= xEnd) {
+        return;
+    }
+    const int w0 = xBegin / MASK_WORD_BITS;
+    const int w1 = (xEnd + MASK_WORD_BITS - 1) / MASK_WORD_BITS;
+    for (int w = w0; w < w1; w++) {
+        const int base = w * MASK_WORD_BITS;
+        const int x0 = std::max(xBegin, base);
+        const int x1 = std::min(xEnd, base + MASK_WORD_BITS);
+        uint64_t word = 0;
+        for (int x = x0; x < x1; x++) {
+            word |= static_cast<uint64_t>(mask[x] & 1) << (x - base);
+        }
+        // 영상 밖 비트는 1 (침식 시 잘린 창과 같은 효과)
+        if (cols - base < MASK_WORD_BITS) {
+            word |= ~0ull << (cols - base);
+        }
+        bits[w] = word;
+    }
+}
+
+void erodeBitsRow(const uint64_t* const* rows, int rowCount, int cols, int xBegin, int xEnd, int ksize,
+                  uint64_t* tmp, uint64_t* out) {
+    // getStructuringElement 기본 앵커는 ksize / 2
+    const int left = ksize / 2;
+    erodeBitsBody(rows, rowCount, cols, xBegin, xEnd, left, ksize - 1 - left, tmp, out);
+}
+
+int accumulateBitsRow(const uint64_t* bits, int xBegin, int xEnd, const uint8_t* bins, int binCount, uint32_t* hist) {
+    const int stride = binCount + 1;
+    int votes = 0;
+    for (int w = xBegin / MASK_WORD_BITS; w * MASK_WORD_BITS < xEnd; w++) {
+        const int base = w * MASK_WORD_BITS;
+        uint64_t word = bits[w];
+        if (base < xBegin) {
+            word &= ~0ull << (xBegin - base);
+        }
+        if (xEnd - base < MASK_WORD_BITS) {
+            word &= (1ull << (xEnd - base)) - 1;
+        }
+        // 설정된 비트만 방문 (빈 워드는 바로 건너뜀)
+        while (word != 0) {
+            const int x = base + lowestBit(word);
+            hist[(x % HIST_LANES) * stride + std::min(static_cast<int>(bins[x]), binCount)]++;
+            votes++;
+            word &= word - 1;
+        }
+    }
+    return votes;
+}
+
+int collectBitsRow(const uint64_t* bits, int xBegin, int xEnd, const uint8_t* bins, const uint8_t* coarseOf,
+                   int coarseCount, uint32_t* coarseHist, uint8_t* votes) {
+    const int stride = coarseCount + 1;
+    int count = 0;
+    for (int w = xBegin / MASK_WORD_BITS; w * MASK_WORD_BITS < xEnd; w++) {
+        const int base = w * MASK_WORD_BITS;
+        uint64_t word = bits[w];
+        if (base < xBegin) {
+            word &= ~0ull << (xBegin - base);
+        }
+        if (xEnd - base < MASK_WORD_BITS) {
+            word &= (1ull << (xEnd - base)) - 1;
+        }
+        while (word != 0) {
+            const int x = base + lowestBit(word);
+            const uint8_t bin = bins[x];
+            coarseHist[(x % HIST_LANES) * stride + coarseOf[bin]]++;
+            votes[count++] = bin;
+            word &= word - 1;
+        }
+    }
+    return count;
+}
+
+void accumulateVotes(const uint8_t* votes, size_t count, int binBegin, int binEnd, int binCount, uint32_t* hist) {
+    const int stride = binCount + 1;
+    const unsigned span = static_cast<unsigned>(binEnd - binBegin);
+    size_t i = 0;
+    for (; i + HIST_LANES <= count; i += HIST_LANES) {
+        for (int lane = 0; lane < HIST_LANES; lane++) {
+            const int bin = votes[i + lane];
+            const bool inside = static_cast<unsigned>(bin - binBegin) < span;
+            hist[lane * stride + (inside ? bin : binCount)]++;
+        }
+    }
+    for (; i < count; i++) {
+        const int bin = votes[i];
+        const bool inside = static_cast<unsigned>(bin - binBegin) < span;
+        hist[inside ? bin : binCount]++;
+    }
+}
+
+int accumulateRow(const uint8_t* mask, const uint8_t* bins, int cols, int binCount, uint32_t* hist) {
+    int votes = 0;
+    for (int x = 0; x < cols; x++) {
+        if (mask[x]) {
+            int bin = bins[x];
+            if (bin < binCount) {
+                hist[bin]++;
+            }
+            votes++;
+        }
+    }
+    return votes;
+}
+
+int accumulateRowLanes(const uint8_t* mask, const uint8_t* bins, int cols, int binCount, uint32_t* hist) {
+    // 이웃 픽셀이 같은 빈에 몰려도 저장-적재 의존이 이어지지 않도록 열마다 다른 부분 히스토그램에 누적
+    const int stride = binCount + 1;
+    uint32_t* lanes[HIST_LANES];
+    for (int lane = 0; lane < HIST_LANES; lane++) {
+        lanes[lane] = hist + static_cast<size_t>(lane) * stride;
+    }
+    int votes = 0;
+    int x = 0;
+    for (; x + HIST_LANES <= cols; x += HIST_LANES) {
+        for (int lane = 0; lane < HIST_LANES; lane++) {
+            const uint8_t m = mask[x + lane];
+            lanes[lane][std::min(static_cast<int>(bins[x + lane]), binCount)] += m;
+            votes += m;
+        }
+    }
+    for (; x < cols; x++) {
+        const uint8_t m = mask[x];
+        lanes[0][std::min(static_cast<int>(bins[x]), binCount)] += m;
+        votes += m;
+    }
+    return votes;
+}
+
+void foldHistLanes(uint32_t* hist, int binCount) {
+    const int stride = binCount + 1;
+    for (int lane = 1; lane < HIST_LANES; lane++) {
+        const uint32_t* src = hist + static_cast<size_t>(lane) * stride;
+        for (int b = 0; b < stride; b++) {
+            hist[b] += src[b];
+        }
+    }
+}
+
+template <int BinCount, int BlurSize, int ErodeSize>
+void HOGKernel<BinCount, BlurSize, ErodeSize>::blurRowH(const uint8_t* src, int cols, int xBegin, int xEnd,
+                                                        const uint16_t* taps, int, uint16_t* dst) {
+    constexpr int r = BlurSize / 2;
+    std::array<uint32_t, r + 1> t;
+    for (int i = 0; i <= r; i++) {
+        t[i] = taps[i];
+    }
+    
+    // 경계 열은 접기 적용, 내부 열은 대칭 계수로 곱셈을 절반으로 줄임
+    auto edge = [&](int begin, int end) {
+        for (int x = begin; x < end; x++) {
+            uint32_t acc = 0;
+            for (int i = 0; i < BlurSize; i++) {
+                acc += taps[i] * src[reflect101(x - r + i, cols)];
+            }
+            dst[x] = static_cast<uint16_t>(acc);
+        }
+    };
+    const int midBegin = std::clamp(r, xBegin, std::max(xBegin, xEnd));
+    const int midEnd = std::clamp(cols - r, midBegin, std::max(midBegin, xEnd));
+    edge(xBegin, midBegin);
+    for (int x = midBegin; x < midEnd; x++) {
+        const uint8_t* s = src + x - r;
+        uint32_t acc = t[r] * s[r];
+        for (int i = 0; i < r; i++) {
+            acc += t[i] * (s[i] + s[BlurSize - 1 - i]);
+        }
+        dst[x] = static_cast<uint16_t>(acc);
+    }
+    edge(midEnd, xEnd);
+}
+
+template <int BinCount, int BlurSize, int ErodeSize>
+void HOGKernel<BinCount, BlurSize, ErodeSize>::blurRowV(const uint16_t* const* rows, int cols, const uint16_t* taps,
+                                                        int, uint8_t* dst) {
+    constexpr int r = BlurSize / 2;
+    std::array<uint32_t, r + 1> t;
+    std::array<const uint16_t*, BlurSize> w;
+    for (int i = 0; i <= r; i++) {
+        t[i] = taps[i];
+    }
+    for (int i = 0; i < BlurSize; i++) {
+        w[i] = rows[i];
+    }
+    for (int x = 0; x < cols; x++) {
+        uint32_t acc = t[r] * w[r][x];
+        for (int i = 0; i < r; i++) {
+            acc += t[i] * (static_cast<uint32_t>(w[i][x]) + w[BlurSize - 1 - i][x]);
+        }
+        dst[x] = static_cast<uint8_t>((acc + (1u << 15)) >> 16);
+    }
+}
+
+template <int BinCount, int BlurSize, int ErodeSize>
+void HOGKernel<BinCount, BlurSize, ErodeSize>::erodeBitsRow(const uint64_t* const* rows, int rowCount, int cols,
+                                                            int xBegin, int xEnd, int, uint64_t* tmp, uint64_t* out) {
+    // 이동 거리가 상수이므로 워드별 이동/AND 가 펼쳐짐
+    erodeBitsBody(rows, rowCount, cols, xBegin, xEnd, ErodeSize / 2, ErodeSize - 1 - ErodeSize / 2, tmp, out);
+}
+
+template <int BinCount, int BlurSize, int ErodeSize>
+int HOGKernel<BinCount, BlurSize, ErodeSize>::accumulateRow(const uint8_t* mask, const uint8_t* bins, int cols, int,
+                                                            uint32_t* hist) {
+    // 마스크는 0/1 이므로 분기 없이 더하고, 범위 밖 빈은 마지막 칸으로 모음
+    // (열마다 HIST_LANES 개 부분 히스토그램을 번갈아 사용)
+    constexpr int STRIDE = BinCount + 1;
+    int votes = 0;
+    int x = 0;
+    for (; x + HIST_LANES <= cols; x += HIST_LANES) {
+        for (int lane = 0; lane < HIST_LANES; lane++) {
+            const uint8_t m = mask[x + lane];
+            hist[lane * STRIDE + std::min(static_cast<int>(bins[x + lane]), BinCount)] += m;
+            votes += m;
+        }
+    }
+    for (; x < cols; x++) {
+        const uint8_t m = mask[x];
+        hist[std::min(static_cast<int>(bins[x]), BinCount)] += m;
+        votes += m;
+    }
+    return votes;
+}
+
+namespace {
+
+#if VV_SIMD_MULTIVERSION
+// 같은 본문을 대상 ISA 로 다시 컴파일한 그래디언트/방향 빈 커널
+#define VV_DEFINE_SIMD_KERNELS(SUFFIX, ISA)                                                                           \
+    VV_TARGET(ISA) void sobelRow##SUFFIX(const uint8_t* up, const uint8_t* cur, const uint8_t* down, int cols,        \
+                                         int xBegin, int xEnd, int16_t* gx, int16_t* gy) {                            \
+        sobelRowBody(up, cur, down, cols, xBegin, xEnd, gx, gy);                                                      \
+    }                                                                                                                 \
+    VV_TARGET(ISA) void thresholdRow##SUFFIX(const int16_t* gx, const int16_t* gy, int cols, float magMin,            \
+                                             float invRange, float threshold,                                         \
+                                             uint8_t* __restrict mask, uint8_t* __restrict bins) {                    \
+        thresholdRowBody<true>(gx, gy, cols, magMin, invRange, threshold, mask, bins);                                \
+    }                                                                                                                 \
+    VV_TARGET(ISA) void thresholdRowInt##SUFFIX(const int16_t* gx, const int16_t* gy, int cols, int32_t thresholdSq,  \
+                                                uint8_t* __restrict mask, uint8_t* __restrict bins) {                 \
+        thresholdRowIntBody<true>(gx, gy, cols, thresholdSq, mask, bins);                                             \
+    }                                                                                                                 \
+    VV_TARGET(ISA) void thresholdRowLut##SUFFIX(const int16_t* gx, const int16_t* gy, int cols, int32_t thresholdSq,  \
+                                                uint8_t* __restrict mask, uint8_t* __restrict bins) {                 \
+        thresholdRowLutBody(gx, gy, cols, thresholdSq, mask, bins);                                                   \
+    }
+
+VV_DEFINE_SIMD_KERNELS(Sse42, "sse4.2")
+VV_DEFINE_SIMD_KERNELS(Avx2, "avx2")
+VV_DEFINE_SIMD_KERNELS(Avx512, VV_AVX512_TARGET)
+
+#undef VV_DEFINE_SIMD_KERNELS
+#endif
+
+SimdLevel detectSimdLevelImpl() {
+#if VV_SIMD_MULTIVERSION
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")
+        && __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512dq")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return SimdLevel::SSE42;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+// 아직 정하지 않았음을 나타내는 값 (첫 조회 때 VV_SIMD 환경 변수 또는 CPU 감지 결과로 채움)
+constexpr int SIMD_UNSET = -1;
+std::atomic<int> g_simdLevel{ SIMD_UNSET };
+
+template <int BinCount, int BlurSize, int ErodeSize>
+constexpr KernelTable specializedKernels() {
+    using K = HOGKernel<BinCount, BlurSize, ErodeSize>;
+    return { &K::blurRowH, &K::blurRowV, &K::erodeBitsRow, &K::accumulateRow,
+             &sobelRow, &thresholdRow, &thresholdRowInt, &thresholdRowLut, true, SimdLevel::Scalar };
+}
+
+struct KernelEntry {
+    int binCount, blurSize, erodeSize;
+    KernelTable table;
+};
+
+const KernelTable GENERIC_KERNELS = { &blurRowH, &blurRowV, &erodeBitsRow, &accumulateRowLanes,
+                                      &sobelRow, &thresholdRow, &thresholdRowInt, &thresholdRowLut,
+                                      false, SimdLevel::Scalar };
+
+const KernelEntry SPECIALIZED_KERNELS[] = {
+    { 180, 11, 3, specializedKernels<180, 11, 3>() },
+    { 180, 7, 3, specializedKernels<180, 7, 3>() },
+    { 180, 15, 3, specializedKernels<180, 15, 3>() },
+    { 180, 11, 5, specializedKernels<180, 11, 5>() },
+    { 90, 11, 3, specializedKernels<90, 11, 3>() },
+};
+
+} // namespace
+
+SimdLevel detectSimdLevel() {
+    static const SimdLevel detected = detectSimdLevelImpl();
+    return detected;
+}
+
+SimdLevel activeSimdLevel() {
+    int level = g_simdLevel.load(std::memory_order_relaxed);
+    if (level == SIMD_UNSET) {
+        SimdLevel chosen = detectSimdLevel();
+        SimdLevel requested;
+        const char* env = std::getenv("VV_SIMD");
+        if (env != nullptr && parseSimdLevel(env, requested) && requested <= chosen) {
+            chosen = requested;
+        }
+        int expected = SIMD_UNSET;
+        g_simdLevel.compare_exchange_strong(expected, static_cast<int>(chosen));
+        level = g_simdLevel.load(std::memory_order_relaxed);
+    }
+    return static_cast<SimdLevel>(level);
+}
+
+bool setSimdLevel(SimdLevel level) {
+    if (level > detectSimdLevel()) {
+        return false;
+    }
+    g_simdLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+    return true;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SSE42: return "sse4.2";
+        case SimdLevel::AVX2: return "avx2";
+        case SimdLevel::AVX512: return "avx512";
+        default: return "scalar";
+    }
+}
+
+bool parseSimdLevel(const char* name, SimdLevel& level) {
+    const SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::SSE42, SimdLevel::AVX2, SimdLevel::AVX512 };
+    for (SimdLevel candidate : levels) {
+        if (std::strcmp(name, simdLevelName(candidate)) == 0) {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+KernelTable selectKernels(int binCount, int blurSize, int erodeSize) {
+    KernelTable table = GENERIC_KERNELS;
+    for (const KernelEntry& entry : SPECIALIZED_KERNELS) {
+        if (entry.binCount == binCount && entry.blurSize == blurSize && entry.erodeSize == erodeSize) {
+            table = entry.table;
+            break;
+        }
+    }
+    
+    // 그래디언트/방향 빈 커널은 활성 SIMD 수준에 맞는 변형으로 교체
+    table.simd = activeSimdLevel();
+    switch (table.simd) {
+#if VV_SIMD_MULTIVERSION
+        case SimdLevel::SSE42:
+            table.sobelRow = &sobelRowSse42;
+            table.thresholdRow = &thresholdRowSse42;
+            table.thresholdRowInt = &thresholdRowIntSse42;
+            table.thresholdRowLut = &thresholdRowLutSse42;
+            break;
+        case SimdLevel::AVX2:
+            table.sobelRow = &sobelRowAvx2;
+            table.thresholdRow = &thresholdRowAvx2;
+            table.thresholdRowInt = &thresholdRowIntAvx2;
+            table.thresholdRowLut = &thresholdRowLutAvx2;
+            break;
+        case SimdLevel::AVX512:
+            table.sobelRow = &sobelRowAvx512;
+            table.thresholdRow = &thresholdRowAvx512;
+            table.thresholdRowInt = &thresholdRowIntAvx512;
+            table.thresholdRowLut = &thresholdRowLutAvx512;
+            break;
+#endif
+        default:
+            table.simd = SimdLevel::Scalar;
+            break;
+    }
+    return table;
+}
+
+} // namespace kernel
+} // namespace vv
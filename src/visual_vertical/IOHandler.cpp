@@ -4,6 +4,7 @@
 #include <chrono>
 #include <iomanip>
 #include <sstream>
+#include <utility>
 #include <opencv2/imgproc.hpp>
 #include <opencv2/videoio.hpp>
 #include <filesystem> // C++17 파일 시스템 기능 추가
@@ -11,6 +12,30 @@
 
 namespace vv {
 
+namespace {
+
+// FOURCC 코드를 문자열로 (예: "YUYV")
+std::string fourccToString(int fourcc) {
+    std::string text(4, ' ');
+    for (int i = 0; i < 4; i++) {
+        const char c = static_cast<char>((fourcc >> (8 * i)) & 0xFF);
+        text[i] = (c >= 32 && c < 127) ? c : '?';
+    }
+    return text;
+}
+
+} // namespace
+
+int IOHandler::captureApi(CaptureBackend backend) {
+    switch (backend) {
+        case CaptureBackend::V4L2:  return cv::CAP_V4L2;
+        case CaptureBackend::DShow: return cv::CAP_DSHOW;
+        case CaptureBackend::MSMF:  return cv::CAP_MSMF;
+        case CaptureBackend::Auto:
+        default:                    return cv::CAP_ANY;
+    }
+}
+
 IOHandler::IOHandler(const Config& config)
     : m_config(config) {
     
@@ -63,7 +88,9 @@ IOHandler::IOHandler(const Config& config)
 }
 
 IOHandler::~IOHandler() {
-    // 리소스 정리
+    // 리소스 정리 (디코딩 스레드를 먼저 멈춘 뒤 캡처 해제)
+    stopReadAhead();
+    
     if (m_videoCapture.isOpened()) {
         m_videoCapture.release();
     }
@@ -76,9 +103,22 @@ IOHandler::~IOHandler() {
 }
 
 bool IOHandler::openVideoSource() {
+    m_openTime = FrameQueue::Clock::now();
+    m_startupLatencyMs = -1.0;
+    
     if (m_config.useCamera) {
-        m_videoCapture.open(m_config.cameraPort, cv::CAP_DSHOW);
+        // 지정한 백엔드로 열 수 없으면 (예: 다른 플랫폼의 백엔드) 자동 선택으로 다시 시도
+        m_captureApi = captureApi(m_config.captureBackend);
+        m_videoCapture.open(m_config.cameraPort, m_captureApi);
+        if (!m_videoCapture.isOpened() && m_captureApi != cv::CAP_ANY) {
+            std::cerr << "Warning: Requested capture backend could not open camera #" << m_config.cameraPort
+                      << "; falling back to automatic backend selection." << std::endl;
+            m_captureApi = cv::CAP_ANY;
+            m_videoCapture.open(m_config.cameraPort, m_captureApi);
+        }
     } else {
+        // 파일 입력은 캡처 백엔드 설정과 무관하게 자동 선택
+        m_captureApi = cv::CAP_ANY;
         m_videoCapture.open(m_config.inputFilePath);
     }
     
@@ -90,29 +130,235 @@ bool IOHandler::openVideoSource() {
         return false;
     }
     
+    if (m_config.useCamera) {
+        configureCamera();
+    }
+    
+    // 시각화가 없으면 색 정보가 필요 없으므로 디코더 출력 (Y 평면 포함) 을 BGR 변환 없이 요청
+    m_rawFrames = false;
+    m_frameFormat = PixelFormat::BGR;
+    if (m_config.headless) {
+        m_rawFrames = m_videoCapture.set(cv::CAP_PROP_CONVERT_RGB, 0);
+        if (!m_rawFrames) {
+            std::cout << "Capture backend does not support raw frames; using BGR input." << std::endl;
+        }
+    }
+    
     return true;
 }
 
+void IOHandler::configureCamera() {
+    // V4L2 는 형식을 바꿀 때 스트림을 다시 설정하므로 픽셀 형식 -> 해상도 -> 속도 -> 버퍼 개수 순서로 요청
+    // (OpenCV 의 V4L2 백엔드는 항상 mmap 스트리밍 버퍼를 사용하며, 버퍼 개수는 CAP_PROP_BUFFERSIZE 로 지정)
+    const std::string& fourcc = m_config.captureFourcc;
+    if (fourcc.size() == 4) {
+        m_videoCapture.set(cv::CAP_PROP_FOURCC, cv::VideoWriter::fourcc(fourcc[0], fourcc[1], fourcc[2], fourcc[3]));
+    } else if (!fourcc.empty()) {
+        std::cerr << "Warning: Ignoring capture format '" << fourcc << "' (expected a 4-character code)" << std::endl;
+    }
+    if (m_config.captureWidth > 0) {
+        m_videoCapture.set(cv::CAP_PROP_FRAME_WIDTH, m_config.captureWidth);
+    }
+    if (m_config.captureHeight > 0) {
+        m_videoCapture.set(cv::CAP_PROP_FRAME_HEIGHT, m_config.captureHeight);
+    }
+    if (m_config.captureFps > 0.0) {
+        m_videoCapture.set(cv::CAP_PROP_FPS, m_config.captureFps);
+    }
+    if (m_config.captureBuffers > 0) {
+        m_videoCapture.set(cv::CAP_PROP_BUFFERSIZE, m_config.captureBuffers);
+    }
+    
+    // 드라이버가 실제로 받아들인 설정
+    std::cout << "Camera: " << m_videoCapture.getBackendName() << " "
+              << m_videoCapture.get(cv::CAP_PROP_FRAME_WIDTH) << "x" << m_videoCapture.get(cv::CAP_PROP_FRAME_HEIGHT) << " "
+              << fourccToString(static_cast<int>(m_videoCapture.get(cv::CAP_PROP_FOURCC))) << " @ "
+              << m_videoCapture.get(cv::CAP_PROP_FPS) << " fps, buffers "
+              << m_videoCapture.get(cv::CAP_PROP_BUFFERSIZE) << std::endl;
+}
+
+bool IOHandler::startReadAhead(size_t depth, bool latestOnly) {
+    if (!m_videoCapture.isOpened() || m_frameQueue) {
+        return false;
+    }
+    if (latestOnly && m_config.captureBuffers <= 0) {
+        // 드라이버 쪽에 오래된 프레임이 쌓이지 않도록 내부 버퍼를 최소로 (지원하지 않는 백엔드는 무시)
+        m_videoCapture.set(cv::CAP_PROP_BUFFERSIZE, 1);
+    }
+    m_frameQueue = std::make_unique<FrameQueue>(depth, latestOnly);
+    m_readThread = std::thread(&IOHandler::readAheadLoop, this);
+    return true;
+}
+
+void IOHandler::stopReadAhead() {
+    if (!m_frameQueue) {
+        return;
+    }
+    m_frameQueue->shutdown();
+    if (m_readThread.joinable()) {
+        m_readThread.join();
+    }
+    m_frameQueue.reset();
+}
+
+const FrameQueue* IOHandler::getFrameQueue() const {
+    return m_frameQueue.get();
+}
+
+void IOHandler::readAheadLoop() {
+    // 링의 빈 슬롯에 직접 디코딩 (링이 가득 차면 beginWrite 에서 대기)
+    while (cv::Mat* slot = m_frameQueue->beginWrite()) {
+        PixelFormat format = PixelFormat::BGR;
+        if (!decodeFrame(*slot, format)) {
+            break;
+        }
+        m_frameQueue->commitWrite(format);
+    }
+    m_frameQueue->close();
+}
+
 bool IOHandler::readNextFrame(cv::Mat& frame) {
+    if (m_frameQueue) {
+        FrameQueue::FrameInfo info;
+        if (!m_frameQueue->pop(frame, info)) {
+            return false;
+        }
+        m_frameFormat = info.format;
+        m_frameTimestamp = info.timestamp;
+        m_droppedFrames = info.droppedBefore;
+    } else {
+        if (!decodeFrame(frame, m_frameFormat)) {
+            return false;
+        }
+        m_frameTimestamp = FrameQueue::Clock::now();
+        m_droppedFrames = 0;
+    }
+    
+    // 입력을 연 뒤 첫 프레임까지 걸린 시간
+    if (m_startupLatencyMs < 0.0) {
+        m_startupLatencyMs = std::chrono::duration<double, std::milli>(m_frameTimestamp - m_openTime).count();
+    }
+    return true;
+}
+
+bool IOHandler::decodeFrame(cv::Mat& frame, PixelFormat& format) {
     if (!m_videoCapture.isOpened()) {
         return false;
     }
     
-    return m_videoCapture.read(frame);
+    if (!m_rawFrames) {
+        format = PixelFormat::BGR;
+        return m_videoCapture.read(frame);
+    }
+    
+    if (!m_videoCapture.read(m_rawFrame)) {
+        return false;
+    }
+    if (!detectRawFormat(m_rawFrame, format)) {
+        // 해석할 수 없는 원시 형식 (압축 패킷 등) 이면 BGR 변환으로 되돌리고 다시 읽음
+        std::cerr << "Warning: Unsupported raw frame layout (" << m_rawFrame.cols << "x" << m_rawFrame.rows
+                  << ", type " << m_rawFrame.type() << "); falling back to BGR input." << std::endl;
+        m_videoCapture.set(cv::CAP_PROP_CONVERT_RGB, 1);
+        m_rawFrames = false;
+        format = PixelFormat::BGR;
+        return m_videoCapture.read(frame);
+    }
+    
+    if (m_rawFrame.type() == CV_8UC2) {
+        // 패킹된 YUYV 는 0번 채널이 휘도
+        cv::extractChannel(m_rawFrame, frame, 0);
+    } else {
+        // 버퍼를 교환하여 복사 없이 넘김 (호출자의 이전 버퍼는 다음 원시 프레임 읽기에 재사용)
+        std::swap(frame, m_rawFrame);
+    }
+    return true;
 }
 
-bool IOHandler::setupVideoWriter(int width, int height) {
-    if (!m_videoCapture.isOpened()) {
+bool IOHandler::skipNextFrame() {
+    if (m_frameQueue) {
+        // 이미 디코딩된 프레임이므로 꺼내서 버림 (그 앞에서 버려진 프레임 수는 기록)
+        FrameQueue::FrameInfo info;
+        if (!m_frameQueue->pop(m_skippedFrame, info)) {
+            return false;
+        }
+        m_droppedFrames = info.droppedBefore;
+        return true;
+    }
+    m_droppedFrames = 0;
+    return m_videoCapture.isOpened() && m_videoCapture.grab();
+}
+
+PixelFormat IOHandler::getFrameFormat() const {
+    return m_frameFormat;
+}
+
+FrameQueue::Clock::time_point IOHandler::getFrameTimestamp() const {
+    return m_frameTimestamp;
+}
+
+int IOHandler::getDroppedFrames() const {
+    return m_droppedFrames;
+}
+
+double IOHandler::getStartupLatencyMs() const {
+    return m_startupLatencyMs;
+}
+
+int IOHandler::getCaptureApi() const {
+    return m_captureApi;
+}
+
+bool IOHandler::detectRawFormat(const cv::Mat& frame, PixelFormat& format) const {
+    if (frame.empty() || frame.depth() != CV_8U) {
         return false;
     }
     
-    // 비디오 코덱 및 프레임 레이트 설정
-    int fourcc = cv::VideoWriter::fourcc('m', 'p', '4', 'v');
+    // 백엔드가 속성을 받아들이고도 BGR 로 변환해 주는 경우
+    if (frame.channels() == 3 || frame.channels() == 4) {
+        format = PixelFormat::BGR;
+        return true;
+    }
+    if (frame.channels() == 2) {
+        format = PixelFormat::Gray;
+        return frame.rows > 1;
+    }
+    
+    // 단일 채널: 세로가 프레임 높이의 1.5 배이면 평면 YUV 4:2:0, 같으면 휘도만
+    const int height = static_cast<int>(m_videoCapture.get(cv::CAP_PROP_FRAME_HEIGHT));
+    if (height > 0 && frame.rows == height * 3 / 2 && frame.rows % 3 == 0) {
+        const int fourcc = static_cast<int>(m_videoCapture.get(cv::CAP_PROP_FOURCC));
+        const bool planarUV = fourcc == cv::VideoWriter::fourcc('I', '4', '2', '0') ||
+                              fourcc == cv::VideoWriter::fourcc('I', 'Y', 'U', 'V') ||
+                              fourcc == cv::VideoWriter::fourcc('Y', 'V', '1', '2');
+        format = planarUV ? PixelFormat::I420 : PixelFormat::NV12;
+        return true;
+    }
+    if (frame.rows == height || (height <= 0 && frame.rows > 1)) {
+        format = PixelFormat::Gray;
+        return true;
+    }
+    return false;
+}
+
+double IOHandler::getSourceFps() const {
     double fps = m_videoCapture.get(cv::CAP_PROP_FPS);
     
     if (fps <= 0) {
         fps = 30.0;  // 기본값 설정
     }
+    return fps;
+}
+
+bool IOHandler::setupVideoWriter(int width, int height, double fps) {
+    if (!m_videoCapture.isOpened()) {
+        return false;
+    }
+    
+    // 비디오 코덱 및 프레임 레이트 설정 (렌더링하는 프레임만 기록하므로 호출자가 실제 녹화 속도를 넘김)
+    int fourcc = cv::VideoWriter::fourcc('m', 'p', '4', 'v');
+    if (fps <= 0) {
+        fps = getSourceFps();
+    }
     
     // VideoWriter 열기 전에 디렉토리 존재 여부 재확인
     try {
@@ -149,35 +395,62 @@ bool IOHandler::saveResultsToCSV(const std::vector<VVResult>& results) {
         std::cerr << "Error: No results to save." << std::endl;
         return false;
     }
-    
-    // CSV 파일 열기 전에 디렉토리 존재 여부 재확인
-    try {
-        std::filesystem::path csvPath(m_csvFilePath);
-        std::filesystem::create_directories(csvPath.parent_path());
-    } catch (const std::exception& e) {
-        std::cerr << "Warning: Could not ensure directory exists for csv file: " << e.what() << std::endl;
-    }
-    
-    std::ofstream outFile(m_csvFilePath);
-    if (!outFile.is_open()) {
-        std::cerr << "Error: Could not open file for writing: " << m_csvFilePath << std::endl;
+    if (!appendResultsToCSV(results.data(), results.size())) {
+        closeResultsCSV();
         return false;
     }
+    return closeResultsCSV();
+}
+
+bool IOHandler::appendResultsToCSV(const VVResult* results, size_t count) {
+    if (!m_csvFile.is_open()) {
+        // CSV 파일 열기 전에 디렉토리 존재 여부 재확인
+        try {
+            std::filesystem::path csvPath(m_csvFilePath);
+            std::filesystem::create_directories(csvPath.parent_path());
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: Could not ensure directory exists for csv file: " << e.what() << std::endl;
+        }
+        
+        m_csvFile.open(m_csvFilePath);
+        if (!m_csvFile.is_open()) {
+            std::cerr << "Error: Could not open file for writing: " << m_csvFilePath << std::endl;
+            return false;
+        }
+        
+        // CSV 헤더 작성
+        m_csvFile << "VV_acc_x[m/s^2],VV_acc_y[m/s^2],VV_acc_rad,VV_acc_dig,measured,level,confidence,frame_age_ms,dropped_frames\n";
+        m_csvRows = 0;
+    }
     
-    // CSV 헤더 작성
-    outFile << "VV_acc_x[m/s^2],VV_acc_y[m/s^2],VV_acc_rad,VV_acc_dig" << std::endl;
-    
-    // 데이터 작성
-    for (const auto& result : results) {
-        outFile << result.accX << ","
-                << result.accY << ","
-                << result.angleRad << ","
-                << result.angle << std::endl;
+    // 데이터 작성 (줄마다 flush 하지 않고 한 번에 기록)
+    for (size_t i = 0; i < count; i++) {
+        const VVResult& result = results[i];
+        m_csvFile << result.accX << ","
+                  << result.accY << ","
+                  << result.angleRad << ","
+                  << result.angle << ","
+                  << (result.measured ? 1 : 0) << ","
+                  << result.level << ","
+                  << result.confidence << ","
+                  << result.frameAgeMs << ","
+                  << result.droppedFrames << '\n';
     }
+    m_csvFile.flush();
+    m_csvRows += count;
     
-    outFile.close();
-    std::cout << "Results saved to: " << m_csvFilePath << std::endl;
+    return m_csvFile.good();
+}
+
+bool IOHandler::closeResultsCSV() {
+    if (!m_csvFile.is_open() || m_csvRows == 0) {
+        std::cerr << "Error: No results to save." << std::endl;
+        m_csvFile.close();
+        return false;
+    }
     
+    m_csvFile.close();
+    std::cout << "Results saved to: " << m_csvFilePath << " (" << m_csvRows << " frames)" << std::endl;
     return true;
 }
 
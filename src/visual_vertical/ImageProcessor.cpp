@@ -1,103 +1,1176 @@
 #include "visual_vertical/ImageProcessor.hpp"
+#include "visual_vertical/HOGKernel.hpp"
 #include <opencv2/imgproc.hpp>
 #include <opencv2/highgui.hpp>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
 
 namespace vv {
 
+namespace {
+
+// 타일(가로 띠) 높이. 타일 분할이 영상 크기에만 의존하도록 고정값을 사용한다
+constexpr int TILE_ROWS = 64;
+
+// 가우시안 근사에 쓰는 상자 필터 반복 횟수 (3회면 분산 오차가 충분히 작음)
+constexpr int BOX_PASSES = 3;
+
+// 시간적 모드의 변경 감지용 축소 간격 (가로/세로 4 픽셀마다 한 샘플)
+constexpr int THUMB_STEP = 4;
+
+// 타일 목록을 cv::parallel_for_ 로 나누어 처리하는 루프 본체
+// (std::function 을 거치지 않으므로 호출 자체는 힙 할당이 없음)
+template<typename Tile, typename Fn>
+class TileLoopBody : public cv::ParallelLoopBody {
+public:
+    TileLoopBody(std::vector<Tile>& tiles, const Fn& fn) : m_tiles(tiles), m_fn(fn) {}
+    
+    void operator()(const cv::Range& range) const override {
+        for (int t = range.start; t < range.end; t++) {
+            m_fn(m_tiles[t]);
+        }
+    }
+    
+private:
+    std::vector<Tile>& m_tiles;
+    const Fn& m_fn;
+};
+
+template<typename Tile, typename Fn>
+void forEachTile(std::vector<Tile>& tiles, const Fn& fn) {
+    const int tileCount = static_cast<int>(tiles.size());
+    cv::parallel_for_(cv::Range(0, tileCount), TileLoopBody<Tile, Fn>(tiles, fn), tileCount);
+}
+
+// 선택 마스크 행에서 선택된 픽셀을 모두 포함하는 열 범위와 그 범위가 모두 선택되었는지 계산
+void selectedRange(const uchar* sel, int cols, int& begin, int& end, bool& full) {
+    begin = 0;
+    end = cols;
+    while (begin < end && !sel[begin]) {
+        begin++;
+    }
+    while (end > begin && !sel[end - 1]) {
+        end--;
+    }
+    full = std::all_of(sel + begin, sel + end, [](uchar v) { return v != 0; });
+}
+
+// 8비트 영상을 BGR 패널 영역에 복사 (형식이나 크기가 다를 때만 scratch 를 거침)
+void blitToPanel(const cv::Mat& src, cv::Mat& panel, cv::Mat& scratch) {
+    if (src.data == panel.data) {
+        return;
+    }
+    const cv::Mat* bgr = &src;
+    if (src.channels() != 3) {
+        const int code = (src.channels() == 4) ? cv::COLOR_BGRA2BGR : cv::COLOR_GRAY2BGR;
+        if (src.size() == panel.size()) {
+            cv::cvtColor(src, panel, code);
+            return;
+        }
+        cv::cvtColor(src, scratch, code);
+        bgr = &scratch;
+    }
+    if (bgr->size() == panel.size()) {
+        bgr->copyTo(panel);
+    } else {
+        cv::resize(*bgr, panel, panel.size());
+    }
+}
+
+// [0, 1] 범위 float 매그니튜드를 8비트 회색조로 변환해 BGR 패널 영역에 직접 기록
+// (resized 는 크기가 다를 때만, gray8 은 항상 사용하며 크기가 같으면 재할당 없음)
+void magnitudeToPanel(const cv::Mat& magnitude, cv::Mat& panel, cv::Mat& resized, cv::Mat& gray8) {
+    if (magnitude.empty()) {
+        panel.setTo(cv::Scalar::all(0));
+        return;
+    }
+    const cv::Mat* src = &magnitude;
+    if (magnitude.size() != panel.size()) {
+        cv::resize(magnitude, resized, panel.size());
+        src = &resized;
+    }
+    src->convertTo(gray8, CV_8U, 255);
+    cv::cvtColor(gray8, panel, cv::COLOR_GRAY2BGR);
+}
+
+} // namespace
+
 ImageProcessor::ImageProcessor(const HOGParams& params) 
     : m_params(params) {
-    // 침식 연산을 위한 커널 초기화
-    m_erodeKernel = cv::getStructuringElement(
-        cv::MORPH_RECT, 
-        cv::Size(m_params.erodeKernelSize, m_params.erodeKernelSize)
-    );
+    // 고정소수점 가우시안 커널 초기화
+    m_blurTaps = kernel::gaussianKernelFixedPoint(m_params.blurKernelSize, m_params.blurSigma);
+    m_kernels = kernel::selectKernels(m_params.binCount, static_cast<int>(m_blurTaps.size()),
+                                      std::max(1, m_params.erodeKernelSize));
+    
+    // 격자 샘플링용 블러 + Sobel 합성 계수
+    const int blurSize = static_cast<int>(m_blurTaps.size());
+    m_smoothTaps.resize(blurSize + 2);
+    m_derivTaps.resize(blurSize + 2);
+    kernel::sobelGaussianTaps(m_blurTaps.data(), blurSize, m_smoothTaps.data(), m_derivTaps.data());
+    
+    // 반복 상자 블러 (격자 샘플링은 합성 계수가 필요하므로 가우시안 유지)
+    m_blurRadius = blurSize / 2;
+    if (m_params.blurBackend == BlurBackend::Box && m_params.samplingStride <= 1) {
+        m_boxRadii = kernel::boxBlurRadii(m_params.blurKernelSize, m_params.blurSigma, BOX_PASSES);
+        m_blurRadius = std::accumulate(m_boxRadii.begin(), m_boxRadii.end(), 0);
+    }
+    
+    // 2단계 히스토그램의 빈 값 -> 거친 빈 표 (범위 밖 빈은 거친 범위 밖 칸)
+    const int coarseWidth = m_params.coarseBinWidth;
+    if (coarseWidth > 1 && m_params.samplingStride <= 1) {
+        m_coarseCount = (m_params.binCount + coarseWidth - 1) / coarseWidth;
+        for (int b = 0; b < static_cast<int>(m_coarseOf.size()); b++) {
+            m_coarseOf[b] = static_cast<uint8_t>(b < m_params.binCount ? b / coarseWidth : m_coarseCount);
+        }
+    }
 }
 
 HOGResult ImageProcessor::computeHOG(const cv::Mat& image) {
     HOGResult result;
+    computeHOG(image, result);
+    return result;
+}
+
+void ImageProcessor::prepareWorkspace(const cv::Size& size) {
+    if (m_ws.size == size) {
+        return;
+    }
     
-    // 그레이스케일 변환
-    cv::Mat gray;
-    cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+    const int rows = size.height;
+    const int cols = size.width;
+    const int blurSize = static_cast<int>(m_blurTaps.size());
+    const int erodeSize = std::max(1, m_params.erodeKernelSize);
     
-    // 가우시안 블러 적용
-    cv::GaussianBlur(
-        gray, 
-        gray, 
-        cv::Size(m_params.blurKernelSize, m_params.blurKernelSize), 
-        m_params.blurSigma
-    );
+    m_ws.size = size;
+    m_ws.stride = std::max(1, m_params.samplingStride);
+    m_ws.temporalValid = false;
+    m_ws.totalCounts.assign(m_params.binCount, 0);
+    m_ws.coarseTotal.assign(m_coarseCount, 0);
+    m_ws.blurred.create(size, CV_8U);
     
-    // 0-1 범위로 정규화
-    gray.convertTo(gray, CV_32F);
-    cv::normalize(gray, gray, 0, 1, cv::NORM_MINMAX);
-    
-    // Sobel 그래디언트 계산
-    cv::Mat gx, gy;
-    cv::Sobel(gray, gx, CV_32F, 1, 0);
-    cv::Sobel(gray, gy, CV_32F, 0, 1);
-    gy = -gy; // y 방향 반전 (Python 코드와 일치)
-    
-    // 그래디언트 크기(magnitude)와 방향(angle) 계산
-    cv::Mat mag, ang;
-    cv::cartToPolar(gx, gy, mag, ang);
-    
-    // 각도를 도(degree) 단위로 변환
-    ang = ang * 180 / CV_PI;
-    
-    // 그래디언트 크기 정규화 및 임계값 처리
-    cv::normalize(mag, mag, 0, 1, cv::NORM_MINMAX);
-    
-    cv::Mat magFilter;
-    cv::threshold(mag, magFilter, m_params.thresholdValue, 1, cv::THRESH_BINARY);
-    
-    // 침식 연산 적용
-    cv::erode(magFilter, magFilter, m_erodeKernel);
-    cv::normalize(magFilter, magFilter, 0, 1, cv::NORM_MINMAX);
-    
-    // 각도 조정 (0-179도 범위로)
-    cv::Mat angMod;
-    cv::Mat mask = (ang == 360);
-    ang.copyTo(angMod);
-    angMod.setTo(0, mask);
-    
-    mask = (ang >= 180);
-    // 수정: mask 영역의 값만 변경
-    cv::Mat temp = ang - 180;
-    temp.copyTo(angMod, mask);
-    
-    // 히스토그램 계산
-    std::vector<float> hist(m_params.binCount, 0.0f);
-    
-    // OpenCV의 calcHist 대신 수동으로 히스토그램 계산 (Python 코드와 일치)
-    for (int i = 0; i < angMod.rows; i++) {
-        for (int j = 0; j < angMod.cols; j++) {
-            int bin = static_cast<int>(angMod.at<float>(i, j));
-            if (bin >= 0 && bin < m_params.binCount) {
-                hist[bin] += magFilter.at<float>(i, j);
+    // 타일 분할은 영상 크기에만 의존 (스레드 수와 무관)
+    const int tileCount = std::max(1, (rows + TILE_ROWS - 1) / TILE_ROWS);
+    m_ws.tiles.resize(tileCount);
+    for (int t = 0; t < tileCount; t++) {
+        TileWorkspace& tile = m_ws.tiles[t];
+        tile.rowBegin = std::min(rows, t * TILE_ROWS);
+        tile.rowEnd = std::min(rows, (t + 1) * TILE_ROWS);
+        tile.grayRow.resize(cols);
+        if (m_boxRadii.empty()) {
+            tile.blurRing.resize(static_cast<size_t>(blurSize) * cols);
+            tile.blurRingRow.assign(blurSize, -1);
+            tile.blurWindow.resize(blurSize);
+        } else {
+            // 단계 p 의 순환 버퍼는 다음 세로 상자 창 (2r + 1 행) 과 이동 합에서 뺄 한 행을 담음
+            const int levels = static_cast<int>(m_boxRadii.size());
+            tile.boxTmp.resize(2 * static_cast<size_t>(cols));
+            tile.boxLevels.resize(levels + 1);
+            for (int p = 0; p <= levels; p++) {
+                BoxLevel& level = tile.boxLevels[p];
+                if (p < levels) {
+                    const int slots = 2 * m_boxRadii[p] + 2;
+                    level.ring.resize(static_cast<size_t>(slots) * cols);
+                    level.ringRow.assign(slots, -1);
+                }
+                if (p > 0) {
+                    level.acc.resize(cols);
+                }
             }
         }
+        tile.gx.resize(cols);
+        tile.gy.resize(cols);
+        const int words = kernel::maskWords(cols);
+        tile.maskRow.resize(cols);
+        tile.maskBits.resize(static_cast<size_t>(erodeSize) * words);
+        tile.binRing.resize(static_cast<size_t>(erodeSize) * cols);
+        tile.erodeBitsTmp.resize(words);
+        tile.erodedBits.resize(words);
+        tile.bitWindow.resize(erodeSize);
+        tile.erodeTmp.resize(cols);
+        tile.erodeWindow.resize(erodeSize);
+        // 부분 히스토그램 HIST_LANES 개 (각 묶음의 마지막 칸은 범위 밖 빈, 집계 제외)
+        tile.counts.resize(static_cast<size_t>(m_params.binCount + 1) * kernel::HIST_LANES);
+        if (m_coarseCount > 0) {
+            tile.coarseCounts.resize(static_cast<size_t>(m_coarseCount + 1) * kernel::HIST_LANES);
+            tile.fineVotes.resize(static_cast<size_t>(tile.rowEnd - tile.rowBegin) * cols);
+        }
+        if (m_params.temporal) {
+            const int thumbRows = (tile.rowEnd - tile.rowBegin + THUMB_STEP - 1) / THUMB_STEP;
+            tile.thumb.resize(static_cast<size_t>(thumbRows) * ((cols + THUMB_STEP - 1) / THUMB_STEP));
+        }
+        if (m_ws.stride > 1) {
+            const int filterSize = static_cast<int>(m_smoothTaps.size());
+            tile.grayRing.resize(static_cast<size_t>(filterSize) * cols);
+            tile.grayRingRow.assign(filterSize, -1);
+            tile.grayWindow.resize(filterSize);
+            tile.vSmooth.resize(cols);
+            tile.vDeriv.resize(cols);
+        }
     }
     
-    // 결과 설정
-    result.gradientX = gx;
-    result.gradientY = gy;
-    result.histogram = hist;
-    result.magnitude = mag;
-    result.magnitudeFiltered = magFilter;
+    prepareSelection();
+    prepareLattice();
+}
+
+void ImageProcessor::prepareSelection() {
+    const int rows = m_ws.size.height;
+    const int cols = m_ws.size.width;
+    const bool hasRects = !m_params.roiRects.empty();
+    const bool hasMask = !m_params.roiMask.empty();
     
-    return result;
+    m_ws.selectSpan.assign(rows, ColumnSpan{ 0, cols });
+    m_ws.selectFull.assign(rows, 1);
+    
+    if (hasRects || hasMask) {
+        // 사각형 합집합
+        m_ws.selection.create(m_ws.size, CV_8U);
+        m_ws.selection.setTo(hasRects ? 0 : 1);
+        const cv::Rect frame(0, 0, cols, rows);
+        for (const cv::Rect& rect : m_params.roiRects) {
+            cv::Rect r = rect & frame;
+            for (int y = r.y; y < r.y + r.height; y++) {
+                uchar* sel = m_ws.selection.ptr<uchar>(y);
+                std::fill(sel + r.x, sel + r.x + r.width, static_cast<uchar>(1));
+            }
+        }
+        
+        // 마스크와 교집합
+        if (hasMask) {
+            CV_Assert(m_params.roiMask.type() == CV_8UC1);
+            cv::Mat mask = m_params.roiMask;
+            if (mask.size() != m_ws.size) {
+                cv::resize(m_params.roiMask, mask, m_ws.size, 0, 0, cv::INTER_NEAREST);
+            }
+            for (int y = 0; y < rows; y++) {
+                const uchar* m = mask.ptr<uchar>(y);
+                uchar* sel = m_ws.selection.ptr<uchar>(y);
+                for (int x = 0; x < cols; x++) {
+                    sel[x] = (sel[x] && m[x]) ? 1 : 0;
+                }
+            }
+        }
+        
+        // 행별 선택 범위와 비트 마스크 (침식된 비트 마스크와 워드 단위로 AND)
+        const int words = kernel::maskWords(cols);
+        m_ws.selectBits.resize(static_cast<size_t>(rows) * words);
+        for (int y = 0; y < rows; y++) {
+            ColumnSpan& span = m_ws.selectSpan[y];
+            bool full = false;
+            selectedRange(m_ws.selection.ptr<uchar>(y), cols, span.begin, span.end, full);
+            m_ws.selectFull[y] = full ? 1 : 0;
+            kernel::packMaskRow(m_ws.selection.ptr<uchar>(y), cols, 0, cols, m_ws.selectBits.data() + static_cast<size_t>(y) * words);
+        }
+    } else {
+        m_ws.selection.release();
+        m_ws.selectBits.clear();
+    }
+    
+    // 히스토그램 → 침식 → Sobel → 세로 블러 → 가로 블러 순서로 각 단계가 읽는 이웃만큼 범위 확장
+    const int erodeSize = std::max(1, m_params.erodeKernelSize);
+    const int erodeAbove = erodeSize / 2;
+    const int erodeBelow = erodeSize - 1 - erodeAbove;
+    const int radius = m_blurRadius;
+    dilateSpans(m_ws.selectSpan, erodeAbove, erodeBelow, erodeAbove, erodeBelow, cols, false, m_ws.threshSpan);
+    dilateSpans(m_ws.threshSpan, 1, 1, 1, 1, cols, true, m_ws.blurSpan);
+    dilateSpans(m_ws.blurSpan, radius, radius, 0, 0, cols, true, m_ws.hblurSpan);
+    dilateSpans(m_ws.hblurSpan, 0, 0, radius, radius, cols, true, m_ws.graySpan);
+}
+
+void ImageProcessor::prepareLattice() {
+    const int stride = m_ws.stride;
+    if (stride <= 1) {
+        m_ws.lattice = cv::Size();
+        return;
+    }
+    
+    const int rows = m_ws.size.height;
+    const int cols = m_ws.size.width;
+    const int latRows = (rows + stride - 1) / stride;
+    const int latCols = (cols + stride - 1) / stride;
+    m_ws.lattice = cv::Size(latCols, latRows);
+    m_ws.latGx.create(m_ws.lattice, CV_16S);
+    m_ws.latGy.create(m_ws.lattice, CV_16S);
+    m_ws.latMask.create(m_ws.lattice, CV_8U);
+    m_ws.latBins.create(m_ws.lattice, CV_8U);
+    m_ws.latEroded.create(m_ws.lattice, CV_8U);
+    
+    // 픽셀 선택 마스크를 격자점에서 샘플링
+    m_ws.latSelectSpan.assign(latRows, ColumnSpan{ 0, latCols });
+    m_ws.latSelectFull.assign(latRows, 1);
+    if (!m_ws.selection.empty()) {
+        m_ws.latSelection.create(m_ws.lattice, CV_8U);
+        for (int ly = 0; ly < latRows; ly++) {
+            const uchar* sel = m_ws.selection.ptr<uchar>(ly * stride);
+            uchar* latSel = m_ws.latSelection.ptr<uchar>(ly);
+            for (int lx = 0; lx < latCols; lx++) {
+                latSel[lx] = sel[lx * stride];
+            }
+            ColumnSpan& span = m_ws.latSelectSpan[ly];
+            bool full = false;
+            selectedRange(latSel, latCols, span.begin, span.end, full);
+            m_ws.latSelectFull[ly] = full ? 1 : 0;
+        }
+    } else {
+        m_ws.latSelection.release();
+    }
+    
+    // 침식은 격자 이웃 단위로 수행하되, 가는 에지가 모두 지워지지 않도록 픽셀 단위 창과 비슷한 범위로 줄임
+    // (예: 3x3 침식은 간격 2 에서 2x2, 간격 3 이상에서는 생략)
+    m_ws.latErodeSize = (std::max(1, m_params.erodeKernelSize) + stride - 1) / stride;
+    const int erodeSize = m_ws.latErodeSize;
+    const int erodeAbove = erodeSize / 2;
+    const int erodeBelow = erodeSize - 1 - erodeAbove;
+    dilateSpans(m_ws.latSelectSpan, erodeAbove, erodeBelow, erodeAbove, erodeBelow, latCols, false, m_ws.latThreshSpan);
+    
+    // 격자 행의 합성 필터가 읽는 그레이 행/열 범위
+    const int radius = static_cast<int>(m_smoothTaps.size()) / 2;
+    std::vector<ColumnSpan> filterSpan(rows, ColumnSpan{ cols, 0 });
+    for (int ly = 0; ly < latRows; ly++) {
+        const ColumnSpan& t = m_ws.latThreshSpan[ly];
+        if (!t.empty()) {
+            filterSpan[ly * stride] = ColumnSpan{ std::max(0, t.begin * stride - radius),
+                                                  std::min(cols, (t.end - 1) * stride + radius + 1) };
+        }
+    }
+    dilateSpans(filterSpan, radius, radius, 0, 0, cols, true, m_ws.latGraySpan);
+}
+
+void ImageProcessor::dilateSpans(const std::vector<ColumnSpan>& in, int up, int down, int left, int right,
+                                 int cols, bool reflect, std::vector<ColumnSpan>& out) {
+    const int rows = static_cast<int>(in.size());
+    out.assign(rows, ColumnSpan{ cols, 0 });
+    for (int y = 0; y < rows; y++) {
+        if (in[y].empty()) {
+            continue;
+        }
+        int begin = std::max(0, in[y].begin - left);
+        int end = std::min(cols, in[y].end + right);
+        for (int dy = -up; dy <= down; dy++) {
+            int src = y + dy;
+            if (src < 0 || src >= rows) {
+                if (!reflect) {
+                    continue;
+                }
+                src = kernel::reflect101(src, rows);
+            }
+            out[src].begin = std::min(out[src].begin, begin);
+            out[src].end = std::max(out[src].end, end);
+        }
+    }
+}
+
+void ImageProcessor::detectChangeTile(const cv::Mat& image, TileWorkspace& tile, bool compare) {
+    const int cols = image.cols;
+    const int channels = image.channels();
+    
+    // 축소 휘도 (그레이 입력은 그대로, BGR 은 (B + 2G + R) / 4) 의 절대 차이 합
+    auto luma = [channels](const uchar* p) {
+        return (channels == 1) ? static_cast<int>(p[0]) : (p[0] + 2 * p[1] + p[2]) >> 2;
+    };
+    if (compare) {
+        long long sad = 0;
+        size_t i = 0;
+        for (int y = tile.rowBegin; y < tile.rowEnd; y += THUMB_STEP) {
+            const uchar* src = image.ptr<uchar>(y);
+            for (int x = 0; x < cols; x += THUMB_STEP, i++) {
+                const uchar* p = src + static_cast<size_t>(x) * channels;
+                sad += std::abs(luma(p) - static_cast<int>(tile.thumb[i]));
+            }
+        }
+        tile.changed = sad > m_params.changeThreshold * static_cast<double>(i);
+    } else {
+        tile.changed = true;
+    }
+    
+    // 기준 휘도는 타일을 다시 계산할 때만 갱신 (느린 변화도 누적되면 감지)
+    if (tile.changed) {
+        size_t i = 0;
+        for (int y = tile.rowBegin; y < tile.rowEnd; y += THUMB_STEP) {
+            const uchar* src = image.ptr<uchar>(y);
+            for (int x = 0; x < cols; x += THUMB_STEP, i++) {
+                tile.thumb[i] = static_cast<uint8_t>(luma(src + static_cast<size_t>(x) * channels));
+            }
+        }
+    }
+}
+
+void ImageProcessor::markDirtyTiles(bool all) {
+    std::vector<TileWorkspace>& tiles = m_ws.tiles;
+    if (all) {
+        for (TileWorkspace& tile : tiles) {
+            tile.blurDirty = tile.histDirty = true;
+        }
+        return;
+    }
+    
+    // [begin, end) 행 범위와 겹치는 타일 중 조건을 만족하는 타일이 있는지
+    auto anyOverlap = [&tiles](int begin, int end, bool TileWorkspace::*flag) {
+        for (const TileWorkspace& other : tiles) {
+            if (other.*flag && other.rowBegin < end && other.rowEnd > begin) {
+                return true;
+            }
+        }
+        return false;
+    };
+    
+    // 블러된 행은 입력 행 ± 블러 반지름, 히스토그램 행은 블러된 행 ± (침식 창 + Sobel 1행)에 의존
+    const int radius = m_blurRadius;
+    const int erodeSize = std::max(1, m_params.erodeKernelSize);
+    const int above = erodeSize / 2 + 1;
+    const int below = erodeSize - 1 - erodeSize / 2 + 1;
+    for (TileWorkspace& tile : tiles) {
+        tile.blurDirty = anyOverlap(tile.rowBegin - radius, tile.rowEnd + radius, &TileWorkspace::changed);
+    }
+    for (TileWorkspace& tile : tiles) {
+        tile.histDirty = anyOverlap(tile.rowBegin - above, tile.rowEnd + below, &TileWorkspace::blurDirty);
+    }
+}
+
+void ImageProcessor::blurTile(const cv::Mat& image, TileWorkspace& tile) {
+    if (!m_boxRadii.empty()) {
+        boxBlurTile(image, tile);
+        return;
+    }
+    
+    const int rows = image.rows;
+    const int cols = image.cols;
+    const int channels = image.channels();
+    const int ksize = static_cast<int>(m_blurTaps.size());
+    const int radius = ksize / 2;
+    
+    // 가로 블러 결과는 커널 크기만큼의 순환 버퍼에 원본 행 번호를 붙여 보관하고,
+    // 그레이스케일 변환은 가로 블러 직전에 행 단위로 수행한다 (단일 채널 입력은 변환 없이 사용)
+    std::fill(tile.blurRingRow.begin(), tile.blurRingRow.end(), -1);
+    auto horizontalRow = [&](int srcRow) -> const uint16_t* {
+        int slot = srcRow % ksize;
+        uint16_t* dst = &tile.blurRing[static_cast<size_t>(slot) * cols];
+        if (tile.blurRingRow[slot] != srcRow) {
+            const ColumnSpan& g = m_ws.graySpan[srcRow];
+            const ColumnSpan& h = m_ws.hblurSpan[srcRow];
+            const uint8_t* gray = image.ptr<uchar>(srcRow);
+            if (channels != 1) {
+                kernel::bgrToGrayRow(gray + static_cast<size_t>(g.begin) * channels,
+                                     g.end - g.begin, channels, tile.grayRow.data() + g.begin);
+                gray = tile.grayRow.data();
+            }
+            m_kernels.blurRowH(gray, cols, h.begin, h.end, m_blurTaps.data(), ksize, dst);
+            tile.blurRingRow[slot] = srcRow;
+        }
+        return dst;
+    };
+    
+    int grayMin = 255, grayMax = 0;
+    for (int y = tile.rowBegin; y < tile.rowEnd; y++) {
+        const ColumnSpan& b = m_ws.blurSpan[y];
+        if (b.empty()) {
+            continue;
+        }
+        for (int i = 0; i < ksize; i++) {
+            tile.blurWindow[i] = horizontalRow(kernel::reflect101(y - radius + i, rows)) + b.begin;
+        }
+        uchar* out = m_ws.blurred.ptr<uchar>(y);
+        m_kernels.blurRowV(tile.blurWindow.data(), b.end - b.begin, m_blurTaps.data(), ksize, out + b.begin);
+        
+        for (int x = b.begin; x < b.end; x++) {
+            grayMin = std::min(grayMin, static_cast<int>(out[x]));
+            grayMax = std::max(grayMax, static_cast<int>(out[x]));
+        }
+    }
+    tile.grayMin = grayMin;
+    tile.grayMax = grayMax;
+}
+
+void ImageProcessor::boxBlurTile(const cv::Mat& image, TileWorkspace& tile) {
+    // 세로 이동 합이 열마다 이어지도록 타일 전체가 같은 열 범위 (출력 행 범위의 합집합) 를 계산
+    int begin = image.cols, end = 0;
+    for (int y = tile.rowBegin; y < tile.rowEnd; y++) {
+        begin = std::min(begin, m_ws.blurSpan[y].begin);
+        end = std::max(end, m_ws.blurSpan[y].end);
+    }
+    tile.grayMin = 255;
+    tile.grayMax = 0;
+    if (begin >= end) {
+        return;
+    }
+    tile.boxBegin = begin;
+    tile.boxEnd = end;
+    for (BoxLevel& level : tile.boxLevels) {
+        std::fill(level.ringRow.begin(), level.ringRow.end(), -1);
+        level.accRow = -1;
+    }
+    
+    const int passes = static_cast<int>(m_boxRadii.size());
+    uint32_t* acc = tile.boxLevels[passes].acc.data() + begin;
+    int grayMin = 255, grayMax = 0;
+    for (int y = tile.rowBegin; y < tile.rowEnd; y++) {
+        const ColumnSpan& b = m_ws.blurSpan[y];
+        if (b.empty()) {
+            continue;
+        }
+        boxSlide(image, tile, passes, y);
+        uchar* out = m_ws.blurred.ptr<uchar>(y);
+        kernel::boxAverageRow8(acc, end - begin, m_boxRadii[passes - 1], out + begin);
+        
+        for (int x = b.begin; x < b.end; x++) {
+            grayMin = std::min(grayMin, static_cast<int>(out[x]));
+            grayMax = std::max(grayMax, static_cast<int>(out[x]));
+        }
+    }
+    tile.grayMin = grayMin;
+    tile.grayMax = grayMax;
+}
+
+const uint16_t* ImageProcessor::boxLevelRow(const cv::Mat& image, TileWorkspace& tile, int level, int y) {
+    BoxLevel& lv = tile.boxLevels[level];
+    const int cols = image.cols;
+    const int slots = static_cast<int>(lv.ringRow.size());
+    const int slot = y % slots;
+    uint16_t* dst = &lv.ring[static_cast<size_t>(slot) * cols];
+    if (lv.ringRow[slot] == y) {
+        return dst;
+    }
+    
+    const int begin = tile.boxBegin;
+    const int end = tile.boxEnd;
+    if (level == 0) {
+        // 그레이 변환 후 가로 상자 필터를 반복 (단계마다 남은 반지름만큼 범위를 줄여 감)
+        int halo = m_blurRadius;
+        const int channels = image.channels();
+        const int grayBegin = std::max(0, begin - halo);
+        const int grayEnd = std::min(cols, end + halo);
+        const uint8_t* gray = image.ptr<uchar>(y);
+        if (channels != 1) {
+            kernel::bgrToGrayRow(gray + static_cast<size_t>(grayBegin) * channels,
+                                 grayEnd - grayBegin, channels, tile.grayRow.data() + grayBegin);
+            gray = tile.grayRow.data();
+        }
+        
+        const int passes = static_cast<int>(m_boxRadii.size());
+        const uint16_t* src = nullptr;
+        for (int p = 0; p < passes; p++) {
+            halo -= m_boxRadii[p];
+            uint16_t* out = (p == passes - 1) ? dst : tile.boxTmp.data() + static_cast<size_t>(p % 2) * cols;
+            const int xBegin = std::max(0, begin - halo);
+            const int xEnd = std::min(cols, end + halo);
+            if (p == 0) {
+                kernel::boxRowH(gray, cols, xBegin, xEnd, m_boxRadii[p], out);
+            } else {
+                kernel::boxRowH(src, cols, xBegin, xEnd, m_boxRadii[p], out);
+            }
+            src = out;
+        }
+    } else {
+        boxSlide(image, tile, level, y);
+        kernel::boxAverageRow(lv.acc.data() + begin, end - begin, m_boxRadii[level - 1], dst + begin);
+    }
+    lv.ringRow[slot] = y;
+    return dst;
+}
+
+void ImageProcessor::boxSlide(const cv::Mat& image, TileWorkspace& tile, int level, int y) {
+    BoxLevel& lv = tile.boxLevels[level];
+    if (lv.accRow == y) {
+        return;
+    }
+    
+    const int rows = image.rows;
+    const int radius = m_boxRadii[level - 1];
+    const int begin = tile.boxBegin;
+    const int width = tile.boxEnd - begin;
+    uint32_t* acc = lv.acc.data() + begin;
+    if (lv.accRow >= 0 && lv.accRow == y - 1) {
+        // 창에서 빠지는 행을 먼저 빼고 새 행을 더함 (두 행이 같은 순환 버퍼 슬롯을 써도 안전)
+        kernel::boxSubRow(boxLevelRow(image, tile, level - 1, kernel::reflect101(y - radius - 1, rows)) + begin,
+                          width, acc);
+        kernel::boxAddRow(boxLevelRow(image, tile, level - 1, kernel::reflect101(y + radius, rows)) + begin,
+                          width, acc);
+    } else {
+        std::fill(acc, acc + width, 0u);
+        for (int i = -radius; i <= radius; i++) {
+            kernel::boxAddRow(boxLevelRow(image, tile, level - 1, kernel::reflect101(y + i, rows)) + begin,
+                              width, acc);
+        }
+    }
+    lv.accRow = y;
+}
+
+void ImageProcessor::gradientRangeTile(TileWorkspace& tile) {
+    const cv::Mat& gray = m_ws.blurred;
+    const int rows = gray.rows;
+    const int cols = gray.cols;
+    
+    // 정규화 범위는 선택된 픽셀만으로 계산
+    int32_t minSq = INT32_MAX, maxSq = 0;
+    for (int y = tile.rowBegin; y < tile.rowEnd; y++) {
+        const ColumnSpan& s = m_ws.selectSpan[y];
+        if (s.empty()) {
+            continue;
+        }
+        int16_t* gx = tile.gx.data();
+        int16_t* gy = tile.gy.data();
+        m_kernels.sobelRow(gray.ptr<uchar>(kernel::reflect101(y - 1, rows)), gray.ptr<uchar>(y),
+                           gray.ptr<uchar>(kernel::reflect101(y + 1, rows)), cols, s.begin, s.end, gx, gy);
+        if (m_ws.selectFull[y]) {
+            kernel::magnitudeRange(gx + s.begin, gy + s.begin, s.end - s.begin, minSq, maxSq);
+        } else {
+            kernel::magnitudeRangeMasked(gx + s.begin, gy + s.begin, m_ws.selection.ptr<uchar>(y) + s.begin,
+                                         s.end - s.begin, minSq, maxSq);
+        }
+    }
+    tile.minSq = minSq;
+    tile.maxSq = maxSq;
+}
+
+void ImageProcessor::histogramTile(TileWorkspace& tile, const ThresholdParams& params, HOGResult& result, bool vote) {
+    const cv::Mat& gray = m_ws.blurred;
+    const int rows = gray.rows;
+    const int cols = gray.cols;
+    
+    int16_t* gx = tile.gx.data();
+    int16_t* gy = tile.gy.data();
+    uint8_t* maskRow = tile.maskRow.data();
+    uint64_t* maskBits = tile.maskBits.data();
+    uint8_t* binRing = tile.binRing.data();
+    uint64_t* eroded = tile.erodedBits.data();
+    const int words = kernel::maskWords(cols);
+    const bool debug = !result.magnitudeFiltered.empty();
+    
+    if (vote) {
+        std::fill(tile.counts.begin(), tile.counts.end(), 0u);
+        std::fill(tile.coarseCounts.begin(), tile.coarseCounts.end(), 0u);
+        tile.votes = 0;
+    }
+    const bool twoLevel = m_coarseCount > 0;
+    
+    // 침식 창 크기만큼의 비트 마스크/빈 행을 순환 버퍼로 유지하며 스트리밍
+    // (타일 경계 위아래의 창 절반은 이웃 타일과 겹쳐서 다시 계산)
+    const int ksize = std::max(1, m_params.erodeKernelSize);
+    const int above = ksize / 2;
+    const int below = ksize - 1 - above;
+    
+    int next = std::max(0, tile.rowBegin - above); // 다음에 계산할 마스크 행
+    for (int y = tile.rowBegin; y < tile.rowEnd; y++) {
+        int last = std::min(rows - 1, y + below);
+        for (; next <= last; next++) {
+            const ColumnSpan& t = m_ws.threshSpan[next];
+            const bool owned = next >= tile.rowBegin && next < tile.rowEnd;
+            if (!t.empty()) {
+                const size_t slot = static_cast<size_t>(next % ksize);
+                const int n = t.end - t.begin;
+                m_kernels.sobelRow(gray.ptr<uchar>(kernel::reflect101(next - 1, rows)), gray.ptr<uchar>(next),
+                                   gray.ptr<uchar>(kernel::reflect101(next + 1, rows)), cols, t.begin, t.end, gx, gy);
+                thresholdRow(gx + t.begin, gy + t.begin, n, params, maskRow + t.begin, binRing + slot * cols + t.begin);
+                kernel::packMaskRow(maskRow, cols, t.begin, t.end, maskBits + slot * words);
+            }
+            
+            // 디버그 출력 (0-1 정규화 영상 기준 그래디언트와 정규화된 크기, 계산하지 않은 열은 0)
+            // 겹치는 행은 담당 타일에서만 기록
+            if (!owned || !debug) {
+                continue;
+            }
+            float* gxOut = result.gradientX.ptr<float>(next);
+            float* gyOut = result.gradientY.ptr<float>(next);
+            float* magOut = result.magnitude.ptr<float>(next);
+            const int x0 = t.empty() ? cols : t.begin;
+            const int x1 = t.empty() ? cols : t.end;
+            std::fill(gxOut, gxOut + x0, 0.0f);
+            std::fill(gyOut, gyOut + x0, 0.0f);
+            std::fill(magOut, magOut + x0, 0.0f);
+            for (int x = x0; x < x1; x++) {
+                gxOut[x] = gx[x] * params.gradScale;
+                gyOut[x] = gy[x] * params.gradScale;
+                magOut[x] = (std::sqrt(static_cast<float>(gx[x] * gx[x] + gy[x] * gy[x])) - params.magMin) * params.invRange;
+            }
+            std::fill(gxOut + x1, gxOut + cols, 0.0f);
+            std::fill(gyOut + x1, gyOut + cols, 0.0f);
+            std::fill(magOut + x1, magOut + cols, 0.0f);
+        }
+        
+        float* filtered = debug ? result.magnitudeFiltered.ptr<float>(y) : nullptr;
+        const ColumnSpan& s = m_ws.selectSpan[y];
+        if (s.empty()) {
+            if (debug) {
+                std::fill(filtered, filtered + cols, 0.0f);
+            }
+            continue;
+        }
+        
+        // 세로 창 (영상 밖은 침식에 영향을 주지 않으므로 잘라냄)
+        int first = std::max(0, y - above);
+        int count = 0;
+        for (int r = first; r <= last; r++) {
+            tile.bitWindow[count++] = maskBits + static_cast<size_t>(r % ksize) * words;
+        }
+        m_kernels.erodeBitsRow(tile.bitWindow.data(), count, cols, s.begin, s.end, ksize, tile.erodeBitsTmp.data(), eroded);
+        
+        // 선택 범위 안의 제외 픽셀은 투표하지 않음
+        const int w0 = s.begin / kernel::MASK_WORD_BITS;
+        const int w1 = kernel::maskWords(s.end);
+        if (!m_ws.selectFull[y]) {
+            const uint64_t* sel = m_ws.selectBits.data() + static_cast<size_t>(y) * words;
+            for (int w = w0; w < w1; w++) {
+                eroded[w] &= sel[w];
+            }
+        }
+        const uint8_t* bins = binRing + static_cast<size_t>(y % ksize) * cols;
+        if (vote && twoLevel) {
+            // 거친 빈에 누적하고 빈 값은 피크 주변 세밀 집계를 위해 모아 둠
+            tile.votes += kernel::collectBitsRow(eroded, s.begin, s.end, bins, m_coarseOf.data(), m_coarseCount,
+                                                 tile.coarseCounts.data(), tile.fineVotes.data() + tile.votes);
+        } else if (vote) {
+            tile.votes += kernel::accumulateBitsRow(eroded, s.begin, s.end, bins, m_params.binCount, tile.counts.data());
+        }
+        
+        if (debug) {
+            std::fill(filtered, filtered + s.begin, 0.0f);
+            for (int x = s.begin; x < s.end; x++) {
+                filtered[x] = static_cast<float>((eroded[x / kernel::MASK_WORD_BITS] >> (x % kernel::MASK_WORD_BITS)) & 1);
+            }
+            std::fill(filtered + s.end, filtered + cols, 0.0f);
+        }
+    }
+    
+    // 부분 히스토그램을 첫 묶음으로 합침 (이후 집계는 첫 binCount 칸만 사용)
+    if (vote && twoLevel) {
+        kernel::foldHistLanes(tile.coarseCounts.data(), m_coarseCount);
+    } else if (vote) {
+        kernel::foldHistLanes(tile.counts.data(), m_params.binCount);
+    }
+}
+
+void ImageProcessor::refineHistogram(HOGResult& result) {
+    // 타일 순서대로 거친 히스토그램 병합
+    std::fill(m_ws.coarseTotal.begin(), m_ws.coarseTotal.end(), 0);
+    for (const TileWorkspace& tile : m_ws.tiles) {
+        for (int b = 0; b < m_coarseCount; b++) {
+            m_ws.coarseTotal[b] += tile.coarseCounts[b];
+        }
+    }
+    result.coarseHistogram.resize(m_coarseCount);
+    for (int b = 0; b < m_coarseCount; b++) {
+        result.coarseHistogram[b] = static_cast<float>(m_ws.coarseTotal[b]);
+    }
+    
+    // 탐색 범위와 겹치는 거친 빈 중 최대 빈 (같으면 작은 빈), 그 빈과 양옆 refineRadius 빈이 세밀 집계 창
+    const int width = m_params.coarseBinWidth;
+    const int first = std::max(0, m_params.refineBegin / width);
+    const int last = std::min(m_coarseCount, (m_params.refineEnd + width - 1) / width);
+    int peak = first;
+    for (int b = first + 1; b < last; b++) {
+        if (m_ws.coarseTotal[b] > m_ws.coarseTotal[peak]) {
+            peak = b;
+        }
+    }
+    const int binBegin = std::max(0, peak * width - m_params.refineRadius);
+    const int binEnd = std::min(m_params.binCount, (peak + 1) * width + m_params.refineRadius);
+    
+    // 모아 둔 빈 값만 다시 읽으므로 영상은 다시 읽지 않음
+    forEachTile(m_ws.tiles, [&](TileWorkspace& tile) {
+        std::fill(tile.counts.begin(), tile.counts.end(), 0u);
+        kernel::accumulateVotes(tile.fineVotes.data(), static_cast<size_t>(tile.votes), binBegin, binEnd,
+                                m_params.binCount, tile.counts.data());
+        kernel::foldHistLanes(tile.counts.data(), m_params.binCount);
+    });
+}
+
+void ImageProcessor::thresholdRow(const int16_t* gx, const int16_t* gy, int cols, const ThresholdParams& params,
+                                  uint8_t* mask, uint8_t* bins) const {
+    if (m_params.precision == HOGPrecision::Integer) {
+        m_kernels.thresholdRowInt(gx, gy, cols, params.thresholdSq, mask, bins);
+    } else if (m_params.precision == HOGPrecision::Lookup) {
+        m_kernels.thresholdRowLut(gx, gy, cols, params.thresholdSq, mask, bins);
+    } else {
+        m_kernels.thresholdRow(gx, gy, cols, params.magMin, params.invRange, params.threshold, mask, bins);
+    }
+}
+
+void ImageProcessor::latticeGradientTile(const cv::Mat& image, TileWorkspace& tile) {
+    const int rows = image.rows;
+    const int cols = image.cols;
+    const int channels = image.channels();
+    const int stride = m_ws.stride;
+    const int ksize = static_cast<int>(m_smoothTaps.size());
+    const int radius = ksize / 2;
+    
+    // 그레이 행은 합성 필터 크기만큼의 순환 버퍼에 원본 행 번호를 붙여 보관
+    int grayMin = 255, grayMax = 0;
+    std::fill(tile.grayRingRow.begin(), tile.grayRingRow.end(), -1);
+    // (단일 채널 입력은 변환 없이 입력 행을 그대로 쓰고 값 범위만 한 번 계산)
+    auto grayRow = [&](int srcRow) -> const uint8_t* {
+        int slot = srcRow % ksize;
+        uint8_t* dst = &tile.grayRing[static_cast<size_t>(slot) * cols];
+        const uint8_t* gray = (channels == 1) ? image.ptr<uchar>(srcRow) : dst;
+        if (tile.grayRingRow[slot] != srcRow) {
+            const ColumnSpan& g = m_ws.latGraySpan[srcRow];
+            if (channels != 1) {
+                kernel::bgrToGrayRow(image.ptr<uchar>(srcRow) + static_cast<size_t>(g.begin) * channels,
+                                     g.end - g.begin, channels, dst + g.begin);
+            }
+            for (int x = g.begin; x < g.end; x++) {
+                grayMin = std::min(grayMin, static_cast<int>(gray[x]));
+                grayMax = std::max(grayMax, static_cast<int>(gray[x]));
+            }
+            tile.grayRingRow[slot] = srcRow;
+        }
+        return gray;
+    };
+    
+    // 이 타일이 담당하는 격자 행: ly * stride 가 [rowBegin, rowEnd) 에 속하는 행
+    int32_t minSq = INT32_MAX, maxSq = 0;
+    const int lyBegin = (tile.rowBegin + stride - 1) / stride;
+    const int lyEnd = (tile.rowEnd + stride - 1) / stride;
+    for (int ly = lyBegin; ly < lyEnd; ly++) {
+        const ColumnSpan& t = m_ws.latThreshSpan[ly];
+        if (t.empty()) {
+            continue;
+        }
+        const int y = ly * stride;
+        for (int i = 0; i < ksize; i++) {
+            tile.grayWindow[i] = grayRow(kernel::reflect101(y - radius + i, rows));
+        }
+        
+        // 세로 합성 필터는 격자 열이 읽는 픽셀 열만, 가로 합성 필터는 격자점에서만 계산
+        const int x0 = std::max(0, t.begin * stride - radius);
+        const int x1 = std::min(cols, (t.end - 1) * stride + radius + 1);
+        kernel::verticalDerivativeRow(tile.grayWindow.data(), x0, x1, m_smoothTaps.data(), m_derivTaps.data(), ksize,
+                                      tile.vSmooth.data(), tile.vDeriv.data());
+        int16_t* gx = m_ws.latGx.ptr<int16_t>(ly);
+        int16_t* gy = m_ws.latGy.ptr<int16_t>(ly);
+        kernel::latticeGradientRow(tile.vSmooth.data(), tile.vDeriv.data(), cols, stride, t.begin, t.end,
+                                   m_smoothTaps.data(), m_derivTaps.data(), ksize, gx, gy);
+        
+        // 정규화 범위는 선택된 격자점만으로 계산
+        const ColumnSpan& s = m_ws.latSelectSpan[ly];
+        if (s.empty()) {
+            continue;
+        }
+        if (m_ws.latSelectFull[ly]) {
+            kernel::magnitudeRange(gx + s.begin, gy + s.begin, s.end - s.begin, minSq, maxSq);
+        } else {
+            kernel::magnitudeRangeMasked(gx + s.begin, gy + s.begin, m_ws.latSelection.ptr<uchar>(ly) + s.begin,
+                                         s.end - s.begin, minSq, maxSq);
+        }
+    }
+    tile.grayMin = grayMin;
+    tile.grayMax = grayMax;
+    tile.minSq = minSq;
+    tile.maxSq = maxSq;
+}
+
+void ImageProcessor::latticeThresholdTile(TileWorkspace& tile, const ThresholdParams& params) {
+    const int stride = m_ws.stride;
+    const int lyBegin = (tile.rowBegin + stride - 1) / stride;
+    const int lyEnd = (tile.rowEnd + stride - 1) / stride;
+    for (int ly = lyBegin; ly < lyEnd; ly++) {
+        const ColumnSpan& t = m_ws.latThreshSpan[ly];
+        if (t.empty()) {
+            continue;
+        }
+        thresholdRow(m_ws.latGx.ptr<int16_t>(ly) + t.begin, m_ws.latGy.ptr<int16_t>(ly) + t.begin, t.end - t.begin,
+                     params, m_ws.latMask.ptr<uchar>(ly) + t.begin, m_ws.latBins.ptr<uchar>(ly) + t.begin);
+    }
+}
+
+void ImageProcessor::latticeHistogramTile(TileWorkspace& tile) {
+    const int stride = m_ws.stride;
+    const int latRows = m_ws.lattice.height;
+    const int latCols = m_ws.lattice.width;
+    const int ksize = m_ws.latErodeSize;
+    const int above = ksize / 2;
+    const int below = ksize - 1 - above;
+    
+    std::fill(tile.counts.begin(), tile.counts.end(), 0u);
+    tile.votes = 0;
+    
+    const int lyBegin = (tile.rowBegin + stride - 1) / stride;
+    const int lyEnd = (tile.rowEnd + stride - 1) / stride;
+    for (int ly = lyBegin; ly < lyEnd; ly++) {
+        uchar* eroded = m_ws.latEroded.ptr<uchar>(ly);
+        std::fill(eroded, eroded + latCols, static_cast<uchar>(0));
+        const ColumnSpan& s = m_ws.latSelectSpan[ly];
+        if (s.empty()) {
+            continue;
+        }
+        
+        // 격자 전체가 임계값 단계에서 계산되어 있으므로 이웃 타일의 행도 바로 읽을 수 있음
+        int first = std::max(0, ly - above);
+        int last = std::min(latRows - 1, ly + below);
+        int count = 0;
+        for (int r = first; r <= last; r++) {
+            tile.erodeWindow[count++] = m_ws.latMask.ptr<uchar>(r);
+        }
+        kernel::erodeRow(tile.erodeWindow.data(), count, latCols, s.begin, s.end, ksize, tile.erodeTmp.data(), eroded);
+        
+        if (!m_ws.latSelectFull[ly]) {
+            const uchar* sel = m_ws.latSelection.ptr<uchar>(ly);
+            for (int x = s.begin; x < s.end; x++) {
+                eroded[x] &= sel[x];
+            }
+        }
+        tile.votes += m_kernels.accumulateRow(eroded + s.begin, m_ws.latBins.ptr<uchar>(ly) + s.begin,
+                                              s.end - s.begin, m_params.binCount, tile.counts.data());
+    }
+    kernel::foldHistLanes(tile.counts.data(), m_params.binCount);
+}
+
+void ImageProcessor::latticeDebugTile(TileWorkspace& tile, const ThresholdParams& params, HOGResult& result) {
+    const int stride = m_ws.stride;
+    const int cols = m_ws.size.width;
+    for (int y = tile.rowBegin; y < tile.rowEnd; y++) {
+        const int ly = y / stride;
+        const ColumnSpan& t = m_ws.latThreshSpan[ly];
+        const int16_t* gx = m_ws.latGx.ptr<int16_t>(ly);
+        const int16_t* gy = m_ws.latGy.ptr<int16_t>(ly);
+        const uchar* eroded = m_ws.latEroded.ptr<uchar>(ly);
+        float* gxOut = result.gradientX.ptr<float>(y);
+        float* gyOut = result.gradientY.ptr<float>(y);
+        float* magOut = result.magnitude.ptr<float>(y);
+        float* filtered = result.magnitudeFiltered.ptr<float>(y);
+        for (int x = 0; x < cols; x++) {
+            const int lx = x / stride;
+            filtered[x] = eroded[lx];
+            if (lx < t.begin || lx >= t.end) {
+                gxOut[x] = gyOut[x] = magOut[x] = 0.0f;
+                continue;
+            }
+            gxOut[x] = gx[lx] * params.gradScale;
+            gyOut[x] = gy[lx] * params.gradScale;
+            magOut[x] = (std::sqrt(static_cast<float>(gx[lx] * gx[lx] + gy[lx] * gy[lx])) - params.magMin) * params.invRange;
+        }
+    }
+}
+
+void ImageProcessor::computeHOG(const cv::Mat& image, PixelFormat format, HOGResult& result, HOGOutput output) {
+    computeHOG(hogInput(image, format), result, output);
+}
+
+cv::Mat ImageProcessor::hogInput(const cv::Mat& frame, PixelFormat format) {
+    switch (format) {
+        case PixelFormat::NV12:
+        case PixelFormat::I420:
+            // 두 형식 모두 Y 평면이 앞쪽 2/3 행에 연속으로 저장됨
+            CV_Assert(frame.type() == CV_8UC1 && frame.rows % 3 == 0);
+            return frame.rowRange(0, frame.rows * 2 / 3);
+        default:
+            return frame;
+    }
+}
+
+void ImageProcessor::computeHOG(const cv::Mat& image, HOGResult& result, HOGOutput output) {
+    CV_Assert(image.depth() == CV_8U && (image.channels() == 1 || image.channels() == 3 || image.channels() == 4));
+    prepareWorkspace(image.size());
+    
+    const int rows = image.rows;
+    const int cols = image.cols;
+    std::vector<TileWorkspace>& tiles = m_ws.tiles;
+    
+    // 디버그 영상은 시각화할 때만 만들고, 히스토그램만 필요하면 이전 버퍼도 해제
+    // (타일 커널은 magnitudeFiltered 가 비어 있으면 디버그 출력을 건너뜀)
+    if (output == HOGOutput::Full) {
+        result.gradientX.create(rows, cols, CV_32F);
+        result.gradientY.create(rows, cols, CV_32F);
+        result.magnitude.create(rows, cols, CV_32F);
+        result.magnitudeFiltered.create(rows, cols, CV_32F);
+    } else {
+        result.gradientX.release();
+        result.gradientY.release();
+        result.magnitude.release();
+        result.magnitudeFiltered.release();
+    }
+    
+    const bool sampled = m_ws.stride > 1;
+    const bool twoLevel = m_coarseCount > 0;
+    const bool temporal = m_params.temporal && !sampled;
+    result.coarseBinWidth = twoLevel ? m_params.coarseBinWidth : 0;
+    // 타일 부분 히스토그램은 출력 범위나 결과 객체와 무관하게 재사용하고,
+    // 디버그 영상은 마지막으로 기록한 버퍼에 다시 쓸 때만 바뀐 타일 행을 갱신
+    bool incremental = temporal && m_ws.temporalValid;
+    const bool planesCurrent = incremental && m_ws.lastPlaneData == result.magnitudeFiltered.data;
+    if (sampled) {
+        // 격자 샘플링: 블러 영상 없이 격자점에서만 블러 + Sobel 합성 필터로 그래디언트와 크기 범위 계산
+        forEachTile(tiles, [&](TileWorkspace& tile) { latticeGradientTile(image, tile); });
+    } else {
+        // 시간적 모드: 바뀐 타일과 그 halo 에 걸친 타일만 다시 계산
+        if (temporal) {
+            forEachTile(tiles, [&](TileWorkspace& tile) { detectChangeTile(image, tile, incremental); });
+        }
+        markDirtyTiles(!incremental);
+        
+        // 그레이스케일 변환 및 가우시안 블러
+        forEachTile(tiles, [&](TileWorkspace& tile) {
+            if (tile.blurDirty) {
+                blurTile(image, tile);
+            }
+        });
+        
+        // 1차 패스: 그래디언트 크기 범위 (NORM_MINMAX 정규화용)
+        forEachTile(tiles, [&](TileWorkspace& tile) {
+            if (tile.histDirty) {
+                gradientRangeTile(tile);
+            }
+        });
+    }
+    
+    int grayMin = 255, grayMax = 0;
+    int32_t minSq = INT32_MAX, maxSq = 0;
+    for (const TileWorkspace& tile : tiles) {
+        grayMin = std::min(grayMin, tile.grayMin);
+        grayMax = std::max(grayMax, tile.grayMax);
+        minSq = std::min(minSq, tile.minSq);
+        maxSq = std::max(maxSq, tile.maxSq);
+    }
+    
+    float magMin = std::sqrt(static_cast<float>(minSq));
+    float magMax = std::sqrt(static_cast<float>(maxSq));
+    
+    if (rows == 0 || magMax - magMin <= DBL_EPSILON) {
+        // 평탄한 영상: 정규화된 크기가 모두 0이므로 임계값을 넘는 픽셀이 없음
+        result.gradientX.setTo(0);
+        result.gradientY.setTo(0);
+        result.magnitude.setTo(0);
+        result.magnitudeFiltered.setTo(0);
+        result.histogram.assign(m_params.binCount, 0.0f);
+        result.coarseHistogram.assign(m_coarseCount, 0.0f);
+        m_ws.temporalValid = false;
+        m_ws.recomputedTiles = static_cast<int>(tiles.size());
+        return;
+    }
+    
+    // 0-1 정규화는 그래디언트 방향과 정규화된 크기에 영향을 주지 않으므로
+    // 8비트 영상에서 바로 계산하고, 디버그 출력용 배율만 구해 둔다
+    ThresholdParams params;
+    params.magMin = magMin;
+    params.invRange = 1.0f / (magMax - magMin);
+    params.threshold = static_cast<float>(m_params.thresholdValue);
+    params.gradScale = (grayMax > grayMin) ? 1.0f / (grayMax - grayMin) : 0.0f;
+    
+    // (mag - min) / (max - min) > t  <=>  mag^2 > (min + t * (max - min))^2
+    // 크기 제곱은 정수이므로 제곱한 임계값의 정수부와 비교하면 sqrt 없이 같은 판정
+    double magThreshold = std::sqrt(static_cast<double>(minSq)) +
+                          m_params.thresholdValue * (std::sqrt(static_cast<double>(maxSq)) - std::sqrt(static_cast<double>(minSq)));
+    if (magThreshold < 0.0) {
+        params.thresholdSq = -1;
+    } else {
+        params.thresholdSq = static_cast<int32_t>(std::min(std::floor(magThreshold * magThreshold),
+                                                           static_cast<double>(INT32_MAX)));
+    }
+    params.magThreshold = magThreshold;
+    
+    // 시간적 모드: 임계값 변화가 작으면 이전 임계값을 그대로 써서 재사용하는 타일과 일관성을 유지하고,
+    // 크게 변하면 모든 타일의 히스토그램을 새 임계값으로 다시 계산
+    if (incremental) {
+        const ThresholdParams& last = m_ws.lastParams;
+        if (std::abs(magThreshold - last.magThreshold) <= m_params.thresholdDrift * std::abs(last.magThreshold)) {
+            params = last;
+        } else {
+            for (TileWorkspace& tile : tiles) {
+                tile.histDirty = true;
+            }
+        }
+    }
+    m_ws.lastParams = params;
+    
+    // 2차 패스: 타일별 부분 히스토그램
+    if (sampled) {
+        // 침식이 이웃 타일의 격자 행을 읽으므로 임계값을 먼저 전부 계산
+        forEachTile(tiles, [&](TileWorkspace& tile) { latticeThresholdTile(tile, params); });
+        forEachTile(tiles, [&](TileWorkspace& tile) { latticeHistogramTile(tile); });
+        if (output == HOGOutput::Full) {
+            forEachTile(tiles, [&](TileWorkspace& tile) { latticeDebugTile(tile, params, result); });
+        }
+    } else {
+        // 다시 계산할 타일의 이전 기여분을 전체 히스토그램에서 빼 둠
+        // (2단계 히스토그램은 피크 창이 프레임마다 바뀌므로 모든 타일을 다시 병합)
+        if (incremental && !twoLevel) {
+            for (const TileWorkspace& tile : tiles) {
+                if (tile.histDirty) {
+                    for (int b = 0; b < m_params.binCount; b++) {
+                        m_ws.totalCounts[b] -= tile.counts[b];
+                    }
+                    m_ws.totalVotes -= tile.votes;
+                }
+            }
+        }
+        const bool debug = output == HOGOutput::Full;
+        forEachTile(tiles, [&](TileWorkspace& tile) {
+            if (tile.histDirty) {
+                histogramTile(tile, params, result, true);
+            } else if (debug && (tile.planesStale || !planesCurrent)) {
+                // 히스토그램 없이 계산한 뒤 바뀐 타일은 디버그 영상만 다시 기록
+                histogramTile(tile, params, result, false);
+            }
+            tile.planesStale = debug ? false : tile.planesStale || tile.histDirty;
+        });
+    }
+    if (twoLevel) {
+        refineHistogram(result);
+    } else {
+        result.coarseHistogram.clear();
+    }
+    
+    // 부분 히스토그램을 타일 순서대로 병합 (증분 모드는 새로 계산한 타일만 더함)
+    const bool mergeAll = !incremental || twoLevel;
+    if (mergeAll) {
+        std::fill(m_ws.totalCounts.begin(), m_ws.totalCounts.end(), 0);
+        m_ws.totalVotes = 0;
+    }
+    int recomputed = 0;
+    for (const TileWorkspace& tile : tiles) {
+        if (!incremental || tile.histDirty) {
+            recomputed++;
+        }
+        if (!mergeAll && !tile.histDirty) {
+            continue;
+        }
+        for (int b = 0; b < m_params.binCount; b++) {
+            m_ws.totalCounts[b] += tile.counts[b];
+        }
+        m_ws.totalVotes += tile.votes;
+    }
+    m_ws.recomputedTiles = recomputed;
+    
+    result.histogram.resize(m_params.binCount);
+    for (int b = 0; b < m_params.binCount; b++) {
+        result.histogram[b] = static_cast<float>(m_ws.totalCounts[b]);
+    }
+    const long long votes = m_ws.totalVotes;
+    
+    // 침식 결과가 전부 1이면 기존 NORM_MINMAX 정규화가 모두 0으로 만들었으므로 동일하게 처리
+    const long long points = sampled ? static_cast<long long>(m_ws.lattice.area()) : static_cast<long long>(rows) * cols;
+    if (votes == points) {
+        std::fill(result.histogram.begin(), result.histogram.end(), 0.0f);
+        std::fill(result.coarseHistogram.begin(), result.coarseHistogram.end(), 0.0f);
+        result.magnitudeFiltered.setTo(0);
+        m_ws.temporalValid = false;
+    } else {
+        m_ws.temporalValid = temporal;
+        if (output == HOGOutput::Full) {
+            m_ws.lastPlaneData = result.magnitudeFiltered.data;
+        }
+    }
+}
+
+int ImageProcessor::recomputedTileCount() const {
+    return m_ws.recomputedTiles;
 }
 
 cv::Mat ImageProcessor::resizeImage(const cv::Mat& image, int scale) const {
+    cv::Mat resized;
+    resizeImage(image, scale, resized);
+    return resized;
+}
+
+void ImageProcessor::resizeImage(const cv::Mat& image, int scale, cv::Mat& resized) const {
     if (scale <= 0 || scale == 1) {
-        return image.clone();
+        image.copyTo(resized);
+        return;
     }
     
-    cv::Mat resized;
     cv::resize(
         image, 
         resized, 
@@ -105,14 +1178,25 @@ cv::Mat ImageProcessor::resizeImage(const cv::Mat& image, int scale) const {
         0, 0, 
         cv::INTER_LINEAR
     );
-    
-    return resized;
 }
 
 cv::Mat ImageProcessor::rotateImage(const cv::Mat& image, double angle) const {
-    cv::Point2f center(image.cols / 2.0f, image.rows / 2.0f);
-    cv::Mat rotMat = cv::getRotationMatrix2D(center, angle, 1.0);
     cv::Mat rotated;
+    rotateImage(image, angle, rotated);
+    return rotated;
+}
+
+void ImageProcessor::rotateImage(const cv::Mat& image, double angle, cv::Mat& rotated) const {
+    // cv::getRotationMatrix2D 와 같은 행렬을 Mat 할당 없이 구성
+    double cx = image.cols / 2.0;
+    double cy = image.rows / 2.0;
+    double rad = angle * CV_PI / 180.0;
+    double alpha = std::cos(rad);
+    double beta = std::sin(rad);
+    cv::Matx23d rotMat(
+        alpha, beta, (1 - alpha) * cx - beta * cy,
+        -beta, alpha, beta * cx + (1 - alpha) * cy
+    );
     
     cv::warpAffine(
         image, 
@@ -121,8 +1205,29 @@ cv::Mat ImageProcessor::rotateImage(const cv::Mat& image, double angle) const {
         image.size(), 
         cv::INTER_LINEAR
     );
-    
-    return rotated;
+}
+
+void ImageProcessor::prepareVisualization(const cv::Size& frameSize, int histogramRows) {
+    VisualizationBuffers& vis = m_vis;
+    const int cols = frameSize.width;
+    const int rows = frameSize.height;
+    const cv::Size canvasSize(2 * cols, 2 * rows + histogramRows);
+    if (vis.canvas.size() == canvasSize && vis.canvas.type() == CV_8UC3) {
+        return;
+    }
+
+    // 캔버스 한 장을 할당하고 각 패널은 그 안의 영역 뷰로 둠
+    vis.canvas.create(canvasSize, CV_8UC3);
+    vis.inputPanel = vis.canvas(cv::Rect(0, 0, cols, rows));
+    vis.calibratedPanel = vis.canvas(cv::Rect(cols, 0, cols, rows));
+    vis.magPanel = vis.canvas(cv::Rect(0, rows, cols, rows));
+    vis.magFilteredPanel = vis.canvas(cv::Rect(cols, rows, cols, rows));
+    vis.histPanel = vis.canvas(cv::Rect(0, 2 * rows, 2 * cols, histogramRows));
+}
+
+cv::Mat ImageProcessor::calibratedPanel(const cv::Size& frameSize, int histogramRows) {
+    prepareVisualization(frameSize, histogramRows);
+    return m_vis.calibratedPanel;
 }
 
 cv::Mat ImageProcessor::createVisualization(
@@ -132,61 +1237,40 @@ cv::Mat ImageProcessor::createVisualization(
     const VVResult& vvResult,
     const cv::Mat& histogramImage,
     float fps
-) const {
-    // 원본 이미지에 VV 표시 추가
-    cv::Mat inputWithVV = drawVVIndicators(inputImage.clone(), vvResult);
+) {
+    VisualizationBuffers& vis = m_vis;
+    
+    // 히스토그램 이미지가 없으면 상단 높이의 절반을 흰 패널로 채움
+    const int histogramRows = histogramImage.empty() ? inputImage.rows / 2 : histogramImage.rows;
+    prepareVisualization(inputImage.size(), histogramRows);
     
-    // 보정된 이미지에 수평선 추가
-    cv::Mat calibratedWithLine = calibratedImage.clone();
+    // 원본 이미지에 VV 표시 추가 (패널 영역에 복사한 뒤 그 위에 그림)
+    blitToPanel(inputImage, vis.inputPanel, vis.bgrScratch);
+    drawVVIndicators(vis.inputPanel, vvResult);
+    
+    // 보정된 이미지에 수평선 추가 (calibratedPanel 에 직접 회전했으면 복사 생략)
+    blitToPanel(calibratedImage, vis.calibratedPanel, vis.bgrScratch);
     cv::line(
-        calibratedWithLine, 
-        cv::Point(0, calibratedWithLine.rows / 2), 
-        cv::Point(calibratedWithLine.cols, calibratedWithLine.rows / 2),
+        vis.calibratedPanel, 
+        cv::Point(0, vis.calibratedPanel.rows / 2), 
+        cv::Point(vis.calibratedPanel.cols, vis.calibratedPanel.rows / 2),
         cv::Scalar(0, 0, 0), 
         2, 
         cv::LINE_AA
     );
     
-    // 상단 이미지 가로로 합치기 (원본 + 보정)
-    cv::Mat topRow;
-    cv::hconcat(inputWithVV, calibratedWithLine, topRow);
-    
-    // HOG 결과 이미지 생성
-    cv::Mat hogMag, hogMagFilter;
-    hogResult.magnitude.convertTo(hogMag, CV_8U, 255);
-    hogResult.magnitudeFiltered.convertTo(hogMagFilter, CV_8U, 255);
-    
-    // 단일 채널을 3채널로 변환 (그레이스케일 -> 컬러)
-    cv::Mat hogMagColor, hogMagFilterColor;
-    cv::cvtColor(hogMag, hogMagColor, cv::COLOR_GRAY2BGR);
-    cv::cvtColor(hogMagFilter, hogMagFilterColor, cv::COLOR_GRAY2BGR);
-    
-    // 중간 이미지 가로로 합치기 (HOG 매그니튜드 + 필터링된 매그니튜드)
-    cv::Mat middleRow;
-    cv::hconcat(hogMagColor, hogMagFilterColor, middleRow);
-    
-    // 모든 행 세로로 합치기 전에 크기 조정 확인
-    cv::resize(middleRow, middleRow, topRow.size());
-    
-    // 히스토그램 이미지가 없거나 너비가 다른 경우 수정
-    cv::Mat histImage = histogramImage;
-    if (histImage.empty()) {
-        // 빈 히스토그램 이미지 생성
-        histImage = cv::Mat(topRow.rows / 2, topRow.cols, CV_8UC3, cv::Scalar(255, 255, 255));
-    } 
-    else if (histImage.cols != topRow.cols) {
-        // 너비 맞추기
-        cv::resize(histImage, histImage, cv::Size(topRow.cols, histImage.rows));
-    }
-    
-    // 수직 합치기
-    cv::Mat result;
-    std::vector<cv::Mat> rows;
-    rows.push_back(topRow);
-    rows.push_back(middleRow);
-    rows.push_back(histImage);
-    
-    cv::vconcat(rows, result);
+    // HOG 결과 이미지 (float -> 8비트 회색조 BGR 변환을 패널에 바로 기록)
+    magnitudeToPanel(hogResult.magnitude, vis.magPanel, vis.magResized, vis.mag8U);
+    magnitudeToPanel(hogResult.magnitudeFiltered, vis.magFilteredPanel, vis.magResized, vis.mag8U);
+    
+    // 히스토그램 (너비가 다르면 패널 크기로 조정)
+    if (histogramImage.empty()) {
+        vis.histPanel.setTo(cv::Scalar(255, 255, 255));
+    } else {
+        blitToPanel(histogramImage, vis.histPanel, vis.bgrScratch);
+    }
+    
+    cv::Mat result = vis.canvas;
     
     // FPS 정보 추가
     if (fps > 0.0f) {
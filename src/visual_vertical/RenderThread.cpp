@@ -0,0 +1,159 @@
+#include "visual_vertical/RenderThread.hpp"
+#include <utility>
+
+namespace vv {
+
+RenderThread::RenderThread(RenderCallback render, double maxRate, int every, FrameSink sink, size_t recordQueue)
+    : m_render(std::move(render)), m_sink(std::move(sink)), m_every(every > 1 ? every : 1) {
+    if (maxRate > 0.0) {
+        m_minPeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / maxRate));
+    }
+
+    // 기록하지 않으면 최신 값 우편함 (큐 길이 1), 슬롯은 큐 길이 + 추정 루프 슬롯 + 렌더링 슬롯
+    const size_t capacity = m_sink && recordQueue > 1 ? recordQueue : 1;
+    m_slots.resize(capacity + 2);
+    m_queue.resize(capacity);
+    m_free.reserve(capacity);
+    for (size_t i = m_slots.size() - 1; i > 1; i--) {
+        m_free.push_back(static_cast<int>(i));
+    }
+}
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+void RenderThread::start() {
+    if (m_thread.joinable()) {
+        return;
+    }
+    m_stopping = false;
+    m_thread = std::thread(&RenderThread::run, this);
+}
+
+void RenderThread::stop() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_cond.notify_one();
+    m_thread.join();
+}
+
+bool RenderThread::frameDue() {
+    // n 프레임마다 한 번, 그리고 최대 속도를 넘지 않을 때만
+    const bool everyDue = (m_frameIndex++ % m_every) == 0;
+    if (!everyDue) {
+        return false;
+    }
+    if (m_minPeriod != Clock::duration::zero()) {
+        const Clock::time_point now = Clock::now();
+        if (m_lastDue != Clock::time_point{} && now - m_lastDue < m_minPeriod) {
+            return false;
+        }
+        m_lastDue = now;
+    }
+    return true;
+}
+
+void RenderThread::post(const cv::Mat& frame, const HOGResult& hog, const VVResult& vv, float fps) {
+    // 추정 루프 전용 슬롯에 복사 (렌더링에 쓰는 히스토그램과 매그니튜드만, 크기가 같으면 재할당 없음)
+    RenderSnapshot& slot = m_slots[m_back];
+    frame.copyTo(slot.frame);
+    slot.hog.histogram.assign(hog.histogram.begin(), hog.histogram.end());
+    hog.magnitude.copyTo(slot.hog.magnitude);
+    hog.magnitudeFiltered.copyTo(slot.hog.magnitudeFiltered);
+    slot.vv = vv;
+    slot.fps = fps;
+    slot.repeat = false;
+    enqueueBack();
+}
+
+void RenderThread::postRepeat() {
+    if (!m_sink) {
+        return;
+    }
+    m_slots[m_back].repeat = true;
+    enqueueBack();
+}
+
+void RenderThread::enqueueBack() {
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_sink && m_thread.joinable()) {
+            // 기록 중에는 버리지 않고 렌더링 스레드가 자리를 비울 때까지 기다림
+            m_spaceCond.wait(lock, [this] { return m_queueCount < m_queue.size(); });
+        }
+        if (m_queueCount == m_queue.size()) {
+            // 가장 오래된 스냅샷을 버리고 그 슬롯을 추정 루프 슬롯으로 재사용
+            const int dropped = m_queue[m_queueHead];
+            m_queue[m_queueHead] = m_back;
+            m_queueHead = (m_queueHead + 1) % m_queue.size();
+            m_back = dropped;
+            m_dropped++;
+        } else {
+            m_queue[(m_queueHead + m_queueCount) % m_queue.size()] = m_back;
+            m_queueCount++;
+            m_back = m_free.back();
+            m_free.pop_back();
+        }
+    }
+    m_cond.notify_one();
+}
+
+void RenderThread::run() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait(lock, [this] { return m_queueCount > 0 || m_stopping; });
+            if (m_queueCount == 0) {
+                return;
+            }
+            m_free.push_back(m_front);
+            m_front = m_queue[m_queueHead];
+            m_queueHead = (m_queueHead + 1) % m_queue.size();
+            m_queueCount--;
+        }
+        m_spaceCond.notify_one();
+
+        // 건너뛴 프레임은 다시 그리지 않고 직전 캔버스를 한 번 더 기록
+        const RenderSnapshot& snapshot = m_slots[m_front];
+        if (snapshot.repeat) {
+            if (!m_lastCanvas.empty()) {
+                m_sink(m_lastCanvas);
+            }
+            continue;
+        }
+
+        // 잠금 밖에서 렌더링 (그동안 추정 루프는 다른 슬롯을 사용)
+        m_lastCanvas = m_render(snapshot);
+        m_rendered.fetch_add(1, std::memory_order_relaxed);
+        if (m_lastCanvas.empty()) {
+            continue;
+        }
+        if (m_sink) {
+            m_sink(m_lastCanvas);
+        }
+
+        // 표시 우편함에 넘김 (주 스레드가 가져가지 않은 이전 캔버스는 새 것으로 교체)
+        m_lastCanvas.copyTo(m_displayBack);
+        std::lock_guard<std::mutex> lock(m_displayMutex);
+        std::swap(m_displayBack, m_displayPending);
+        m_hasDisplay = true;
+    }
+}
+
+bool RenderThread::takeDisplayFrame(cv::Mat& canvas) {
+    std::lock_guard<std::mutex> lock(m_displayMutex);
+    if (!m_hasDisplay) {
+        return false;
+    }
+    std::swap(canvas, m_displayPending);
+    m_hasDisplay = false;
+    return true;
+}
+
+} // namespace vv
@@ -0,0 +1,52 @@
+#include "visual_vertical/ResultStore.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace vv {
+
+ResultStore::ResultStore(size_t capacity, DrainCallback drain)
+    : m_buffer(std::max<size_t>(1, capacity)), m_drain(std::move(drain)) {
+}
+
+void ResultStore::push(const VVResult& result) {
+    if (m_size == m_buffer.size()) {
+        if (m_drain) {
+            flush();
+        } else {
+            // 가장 오래된 결과 자리에 덮어씀
+            m_buffer[m_head] = result;
+            m_head = (m_head + 1) % m_buffer.size();
+            m_total++;
+            m_dropped++;
+            return;
+        }
+    }
+    m_buffer[(m_head + m_size) % m_buffer.size()] = result;
+    m_size++;
+    m_total++;
+}
+
+void ResultStore::flush() {
+    if (!m_drain || m_size == 0) {
+        return;
+    }
+
+    // 비움 콜백이 있으면 덮어쓰지 않으므로 보통 한 구간이지만, 감긴 경우 두 구간으로 나눠 넘김
+    const size_t first = std::min(m_size, m_buffer.size() - m_head);
+    m_drain(m_buffer.data() + m_head, first);
+    if (first < m_size) {
+        m_drain(m_buffer.data(), m_size - first);
+    }
+    m_head = 0;
+    m_size = 0;
+}
+
+const VVResult& ResultStore::operator[](size_t index) const {
+    return m_buffer[(m_head + index) % m_buffer.size()];
+}
+
+const VVResult& ResultStore::latest() const {
+    return (*this)[m_size - 1];
+}
+
+} // namespace vv
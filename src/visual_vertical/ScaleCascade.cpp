@@ -0,0 +1,53 @@
+#include "visual_vertical/ScaleCascade.hpp"
+#include <algorithm>
+#include <functional>
+#include <opencv2/imgproc.hpp>
+#include "visual_vertical/VVEstimator.hpp"
+
+namespace vv {
+
+ScaleCascade::ScaleCascade(const HOGParams& params, const std::vector<int>& levels, double confidenceThreshold)
+    : m_levels(levels), m_threshold(confidenceThreshold) {
+    // 거친 단계 (pyrDown 횟수가 큰 단계) 부터, 중복 제거
+    for (int& level : m_levels) {
+        level = std::max(0, level);
+    }
+    std::sort(m_levels.begin(), m_levels.end(), std::greater<int>());
+    m_levels.erase(std::unique(m_levels.begin(), m_levels.end()), m_levels.end());
+    if (m_levels.empty()) {
+        m_levels.push_back(0);
+    }
+    m_pyramid.resize(m_levels.front() + 1);
+
+    // 관심 영역 사각형은 단계 해상도로 축소 (마스크는 computeHOG 에서 크기에 맞춰짐)
+    m_processors.reserve(m_levels.size());
+    for (int level : m_levels) {
+        HOGParams levelParams = params;
+        for (cv::Rect& rect : levelParams.roiRects) {
+            rect = cv::Rect(rect.x >> level, rect.y >> level, rect.width >> level, rect.height >> level);
+        }
+        m_processors.emplace_back(levelParams);
+    }
+}
+
+int ScaleCascade::computeHOG(const cv::Mat& image, HOGResult& result, HOGOutput output) {
+    // 피라미드는 필요한 단계까지만 만들며, 세밀한 단계로 내려갈 때 이미 만든 영상을 재사용
+    int built = 0;
+    for (size_t i = 0; i < m_levels.size(); i++) {
+        const int level = m_levels[i];
+        for (; built < level; built++) {
+            const cv::Mat& src = built == 0 ? image : m_pyramid[built];
+            cv::pyrDown(src, m_pyramid[built + 1]);
+        }
+        const cv::Mat& levelImage = level == 0 ? image : m_pyramid[level];
+
+        m_processors[i].computeHOG(levelImage, result, output);
+        m_confidence = VVEstimator::peakConfidence(result);
+        if (m_confidence >= m_threshold || i + 1 == m_levels.size()) {
+            return level;
+        }
+    }
+    return m_levels.back();
+}
+
+} // namespace vv
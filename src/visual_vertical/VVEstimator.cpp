@@ -1,49 +1,55 @@
 #include "visual_vertical/VVEstimator.hpp"
+#include "visual_vertical/utils/Helpers.hpp"
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <numeric>
+#include <utility>
 #include <opencv2/highgui.hpp>
 #include <opencv2/imgproc.hpp>
 
 namespace vv {
 
-VVEstimator::VVEstimator() {
-    // 초기화
+VVEstimator::VVEstimator(size_t resultCapacity, ResultStore::DrainCallback drain)
+    : m_results(resultCapacity, std::move(drain)) {
 }
 
 VVResult VVEstimator::estimateVV(
     const std::vector<float>& hogHistogram, 
-    const VVResult& previousResult) {
+    const VVResult& previousResult,
+    int level,
+    const FrameTiming& timing) {
+    return estimateFromHistogram(hogHistogram, previousResult, level, timing, peakConfidence(hogHistogram));
+}
+
+VVResult VVEstimator::estimateVV(
+    const HOGResult& hogResult,
+    const VVResult& previousResult,
+    int level,
+    const FrameTiming& timing) {
+    return estimateFromHistogram(hogResult.histogram, previousResult, level, timing, peakConfidence(hogResult));
+}
+
+VVResult VVEstimator::estimateFromHistogram(
+    const std::vector<float>& hogHistogram,
+    const VVResult& previousResult,
+    int level,
+    const FrameTiming& timing,
+    double confidence) {
     
     VVResult result;
+    result.measured = true;
+    result.level = level;
+    result.confidence = confidence;
+    result.frameAgeMs = timing.ageMs;
+    result.droppedFrames = timing.droppedFrames;
     
-    // 최대 3개의 피크 찾기
-    std::vector<int> indices(hogHistogram.size());
-    std::iota(indices.begin(), indices.end(), 0);
-    
-    // MIN_ANGLE ~ MAX_ANGLE 범위에서만 고려
-    auto compareFunc = [&hogHistogram](int i1, int i2) {
-        return hogHistogram[i1] > hogHistogram[i2]; 
-    };
-    
-    // 범위 내의 상위 3개 인덱스 찾기
-    std::vector<int> bestIndices;
-    for (size_t i = 0; i < indices.size(); i++) {
-        if (indices[i] >= MIN_ANGLE && indices[i] <= MAX_ANGLE) {
-            bestIndices.push_back(indices[i]);
-        }
-    }
-    
-    std::partial_sort(
-        bestIndices.begin(), 
-        bestIndices.begin() + std::min(3, static_cast<int>(bestIndices.size())), 
-        bestIndices.end(), 
-        compareFunc
-    );
+    // MIN_ANGLE ~ MAX_ANGLE 범위에서 최대 3개의 피크 찾기 (값 내림차순, 같은 값의 선택은 기존 partial_sort 와 동일)
+    std::array<int, PEAK_COUNT> bestIndices;
+    const int endAngle = std::min(MAX_ANGLE + 1, static_cast<int>(hogHistogram.size()));
+    const int peakCount = utils::argmaxTopN<PEAK_COUNT>(hogHistogram.data(), MIN_ANGLE, endAngle, bestIndices);
     
-    // 상위 3개 인덱스만 사용
-    bestIndices.resize(std::min(3, static_cast<int>(bestIndices.size())));
-    
-    if (bestIndices.empty()) {
+    if (peakCount == 0) {
         // 유효한 인덱스가 없을 경우 이전 결과 반환
         return previousResult;
     }
@@ -52,7 +58,8 @@ VVResult VVEstimator::estimateVV(
     double sumWeights = 0.0;
     double sumWeightedAngles = 0.0;
     
-    for (int idx : bestIndices) {
+    for (int i = 0; i < peakCount; i++) {
+        const int idx = bestIndices[i];
         double weight = hogHistogram[idx];
         sumWeights += weight;
         sumWeightedAngles += idx * weight;
@@ -77,76 +84,156 @@ VVResult VVEstimator::estimateVV(
     result.updateAcceleration();
     
     // 결과 저장
-    m_results.push_back(result);
+    m_results.push(result);
+    
+    return result;
+}
+
+double VVEstimator::peakConfidence(const std::vector<float>& hogHistogram, int binWidth) {
+    // 빈 b 는 [b * width, (b + 1) * width) 도, 너비 1 이면 MIN_ANGLE ~ MAX_ANGLE 빈과 ±PEAK_WINDOW 빈
+    const int width = std::max(1, binWidth);
+    const int beginBin = MIN_ANGLE / width;
+    const int endBin = std::min(MAX_ANGLE / width + 1, static_cast<int>(hogHistogram.size()));
+    const int window = PEAK_WINDOW / width;
+    std::array<int, 1> peak;
+    if (utils::argmaxTopN<1>(hogHistogram.data(), beginBin, endBin, peak) == 0) {
+        return 0.0;
+    }
     
+    double total = 0.0;
+    double near = 0.0;
+    for (int i = beginBin; i < endBin; i++) {
+        total += hogHistogram[i];
+        if (std::abs(i - peak[0]) <= window) {
+            near += hogHistogram[i];
+        }
+    }
+    return total > 0.0 ? near / total : 0.0;
+}
+
+double VVEstimator::peakConfidence(const HOGResult& hogResult) {
+    if (!hogResult.coarseHistogram.empty() && hogResult.coarseBinWidth > 1) {
+        return peakConfidence(hogResult.coarseHistogram, hogResult.coarseBinWidth);
+    }
+    return peakConfidence(hogResult.histogram);
+}
+
+VVResult VVEstimator::carryForward(const VVResult& previousResult, const FrameTiming& timing) {
+    VVResult result = previousResult;
+    result.measured = false;
+    result.frameAgeMs = timing.ageMs;
+    result.droppedFrames = timing.droppedFrames;
+    m_results.push(result);
     return result;
 }
 
-const std::vector<VVResult>& VVEstimator::getAllResults() const {
+const ResultStore& VVEstimator::getResults() const {
     return m_results;
 }
 
+void VVEstimator::flushResults() {
+    m_results.flush();
+}
+
 cv::Mat VVEstimator::createHistogramVisualization(
     const std::vector<float>& hogHistogram,
     const VVResult& vvResult,
     int width,
-    int height) const {
+    int height) {
     
-    // 히스토그램이 비어있는 경우 검사
-    if (hogHistogram.empty()) {
-        return cv::Mat(height, width, CV_8UC3, cv::Scalar(255, 255, 255));
-    }
+    HistogramCanvas& hist = m_hist;
     
-    // 정규화를 위해 합계 계산
+    // 히스토그램이 비어 있거나 합계가 0 이면 흰 영상 (다음 프레임은 전체를 다시 그림)
     float histSum = std::accumulate(hogHistogram.begin(), hogHistogram.end(), 0.0f);
-    if (histSum <= 0) {
-        return cv::Mat(height, width, CV_8UC3, cv::Scalar(255, 255, 255));
+    if (hogHistogram.empty() || histSum <= 0) {
+        hist.canvas.create(height, width, CV_8UC3);
+        hist.canvas.setTo(cv::Scalar(255, 255, 255));
+        hist.canvasValid = false;
+        return hist.canvas;
     }
     
-    // 시각화를 위한 이미지 생성
-    cv::Mat histImage(height, width, CV_8UC3, cv::Scalar(255, 255, 255));
-    
-    // 히스토그램 막대 너비 계산
-    int barWidth = std::max(1, width / static_cast<int>(hogHistogram.size()));
+    prepareHistogramCanvas(width, height, static_cast<int>(hogHistogram.size()));
+    const int barWidth = histogramBarWidth();
     
     // 히스토그램 최대값 찾기 (정규화용)
     float maxVal = *std::max_element(hogHistogram.begin(), hogHistogram.end()) / histSum;
     float scale = 0.8f * height / std::max(maxVal, 0.001f); // 높이의 80%까지 사용
     
-    // 히스토그램 그리기
+    // 높이가 바뀐 막대만 다시 그림 (X축 반전: 180 -> 0)
     for (size_t i = 0; i < hogHistogram.size(); i++) {
         float normVal = hogHistogram[i] / histSum;
         int barHeight = cvRound(normVal * scale);
-        
-        // X축 반전 (180 -> 0)
-        int x = width - static_cast<int>(i) * barWidth - barWidth;
-        
-        cv::rectangle(
-            histImage,
-            cv::Point(x, height - barHeight),
-            cv::Point(x + barWidth, height),
-            cv::Scalar(100, 100, 100),
-            cv::FILLED
-        );
+        if (barHeight != hist.barHeights[i]) {
+            hist.barHeights[i] = barHeight;
+            int x = width - static_cast<int>(i) * barWidth - barWidth;
+            repaintHistogramColumns(x, x + barWidth + 1);
+        }
     }
     
-    // VV 각도 표시
+    // 이전 VV 표시선을 지우고 새 위치에 그림 (두께 2 안티에일리어싱 선이 닿는 열까지)
+    const int markerMargin = 3;
+    if (hist.hasMarker) {
+        repaintHistogramColumns(hist.markerX - markerMargin, hist.markerX + markerMargin + 1);
+    }
     int vvX = width - static_cast<int>(vvResult.angle) * barWidth - barWidth / 2;
     cv::line(
-        histImage,
+        hist.canvas,
         cv::Point(vvX, 0),
         cv::Point(vvX, height),
         cv::Scalar(0, 255, 0),
         2,
         cv::LINE_AA
     );
+    hist.markerX = vvX;
+    hist.hasMarker = true;
+    
+    // 경계선과 눈금은 VV 표시선 위에 보이도록 다시 덮음
+    const int x0 = std::max(0, vvX - markerMargin);
+    const int x1 = std::min(width, vvX + markerMargin + 1);
+    if (x0 < x1) {
+        hist.staticLayer.colRange(x0, x1).copyTo(hist.canvas.colRange(x0, x1), hist.staticMask.colRange(x0, x1));
+    }
+    
+    return hist.canvas;
+}
+
+int VVEstimator::histogramBarWidth() const {
+    return std::max(1, m_hist.size.width / std::max(1, m_hist.bins));
+}
+
+void VVEstimator::prepareHistogramCanvas(int width, int height, int bins) {
+    HistogramCanvas& hist = m_hist;
+    const bool sameLayout = hist.size == cv::Size(width, height) && hist.bins == bins;
+    if (sameLayout && hist.canvasValid) {
+        return;
+    }
+    if (!sameLayout) {
+        drawHistogramStaticLayer(width, height, bins);
+    }
+    
+    // 막대가 없는 캔버스에서 시작
+    hist.staticLayer.copyTo(hist.canvas);
+    hist.barHeights.assign(bins, 0);
+    hist.hasMarker = false;
+    hist.canvasValid = true;
+}
+
+void VVEstimator::drawHistogramStaticLayer(int width, int height, int bins) {
+    HistogramCanvas& hist = m_hist;
+    hist.size = cv::Size(width, height);
+    hist.bins = bins;
+    const int barWidth = histogramBarWidth();
+    
+    // 정적 레이어: 흰 배경에 30도, 150도 경계선과 X축 눈금/레이블
+    hist.staticLayer.create(height, width, CV_8UC3);
+    hist.staticLayer.setTo(cv::Scalar(255, 255, 255));
+    cv::Mat& layer = hist.staticLayer;
     
-    // 30도, 150도 경계선 표시
     int x30 = width - MIN_ANGLE * barWidth - barWidth / 2;
     int x150 = width - MAX_ANGLE * barWidth - barWidth / 2;
     
     cv::line(
-        histImage,
+        layer,
         cv::Point(x30, 0),
         cv::Point(x30, height),
         cv::Scalar(0, 0, 0),
@@ -155,7 +242,7 @@ cv::Mat VVEstimator::createHistogramVisualization(
     );
     
     cv::line(
-        histImage,
+        layer,
         cv::Point(x150, 0),
         cv::Point(x150, height),
         cv::Scalar(0, 0, 0),
@@ -163,14 +250,13 @@ cv::Mat VVEstimator::createHistogramVisualization(
         cv::LINE_AA
     );
     
-    // X축 눈금 추가
     int tickStep = 30;
     for (int angle = 0; angle <= 180; angle += tickStep) {
         int x = width - angle * barWidth - barWidth / 2;
         
         // 눈금 선
         cv::line(
-            histImage,
+            layer,
             cv::Point(x, height - 5),
             cv::Point(x, height),
             cv::Scalar(0, 0, 0),
@@ -180,7 +266,7 @@ cv::Mat VVEstimator::createHistogramVisualization(
         
         // 눈금 레이블
         cv::putText(
-            histImage,
+            layer,
             std::to_string(angle),
             cv::Point(x - 10, height - 10),
             cv::FONT_HERSHEY_SIMPLEX,
@@ -191,7 +277,47 @@ cv::Mat VVEstimator::createHistogramVisualization(
         );
     }
     
-    return histImage;
+    // 배경이 아닌 픽셀 마스크 (막대를 그린 뒤 이 픽셀만 정적 레이어로 덮음)
+    hist.staticMask.create(height, width, CV_8U);
+    for (int y = 0; y < height; y++) {
+        const uchar* src = layer.ptr<uchar>(y);
+        uchar* dst = hist.staticMask.ptr<uchar>(y);
+        for (int x = 0; x < width; x++) {
+            dst[x] = (src[3 * x] & src[3 * x + 1] & src[3 * x + 2]) != 255 ? 255 : 0;
+        }
+    }
+
+}
+
+void VVEstimator::repaintHistogramColumns(int x0, int x1) {
+    HistogramCanvas& hist = m_hist;
+    const int width = hist.size.width;
+    const int height = hist.size.height;
+    x0 = std::max(0, x0);
+    x1 = std::min(width, x1);
+    if (x0 >= x1) {
+        return;
+    }
+    
+    // 정적 레이어로 되돌린 뒤 이 열에 걸친 막대를 원래 순서대로 그리고, 정적 픽셀을 다시 덮음
+    cv::Mat canvas = hist.canvas.colRange(x0, x1);
+    hist.staticLayer.colRange(x0, x1).copyTo(canvas);
+    
+    const int barWidth = histogramBarWidth();
+    for (int i = 0; i < hist.bins; i++) {
+        int x = width - i * barWidth - barWidth;
+        if (x > x1 - 1 || x + barWidth < x0 || hist.barHeights[i] <= 0) {
+            continue;
+        }
+        cv::rectangle(
+            canvas,
+            cv::Point(x - x0, height - hist.barHeights[i]),
+            cv::Point(x + barWidth - x0, height),
+            cv::Scalar(100, 100, 100),
+            cv::FILLED
+        );
+    }
+    hist.staticLayer.colRange(x0, x1).copyTo(canvas, hist.staticMask.colRange(x0, x1));
 }
 
 } // namespace vv 
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <vector>
+#include "visual_vertical/AdaptiveSkipper.hpp"
+
+namespace {
+
+// 여러 방향의 줄무늬와 잡음이 섞인 640x360 테스트 영상
+cv::Mat createTexturedImage() {
+    cv::Mat image(360, 640, CV_8UC3, cv::Scalar(90, 90, 90));
+    cv::line(image, cv::Point(320, 0), cv::Point(320, 360), cv::Scalar(255, 255, 255), 6);
+    cv::line(image, cv::Point(100, 350), cv::Point(250, 50), cv::Scalar(20, 20, 20), 4);
+    cv::rectangle(image, cv::Point(420, 80), cv::Point(580, 300), cv::Scalar(200, 180, 160), cv::FILLED);
+    cv::Mat noise(image.size(), CV_8UC3);
+    cv::RNG rng(12345);
+    rng.fill(noise, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(24));
+    image += noise;
+    return image;
+}
+
+} // namespace
+
+// 장면이 안정적이면 측정 간격이 상한까지 늘어나고, 변화가 감지되면 바로 매 프레임 측정으로 돌아가는지 테스트
+TEST(AdaptiveSkipperTest, BacksOffOnStableScene) {
+    cv::Mat image = createTexturedImage();
+    vv::AdaptiveSkipper skipper(4);
+    
+    // 같은 장면이 이어지면 측정 사이 건너뛰는 프레임 수가 1, 3, 3 (상한 4 프레임마다 측정)
+    std::vector<int> skipped;
+    int measured = 0;
+    for (int frame = 0; frame < 16; frame++) {
+        if (!skipper.shouldMeasure()) {
+            skipper.frameSkipped();
+            continue;
+        }
+        EXPECT_EQ(skipper.frameMeasured(image), measured == 0);
+        skipped.push_back(skipper.skipInterval());
+        measured++;
+    }
+    EXPECT_EQ(skipped, (std::vector<int>{ 0, 1, 3, 3, 3, 3 }));
+    
+    // 장면이 바뀌면 다음 프레임부터 다시 측정
+    while (!skipper.shouldMeasure()) {
+        skipper.frameSkipped();
+    }
+    cv::Mat shifted;
+    image.convertTo(shifted, -1, 1.0, 40.0);
+    EXPECT_TRUE(skipper.frameMeasured(shifted));
+    EXPECT_TRUE(skipper.shouldMeasure());
+    
+    // 건너뛰기를 사용하지 않으면 항상 측정
+    vv::AdaptiveSkipper disabled(1);
+    disabled.frameMeasured(image);
+    disabled.frameMeasured(image);
+    EXPECT_TRUE(disabled.shouldMeasure());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
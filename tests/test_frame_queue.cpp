@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <opencv2/core.hpp>
+#include "visual_vertical/FrameQueue.hpp"
+
+// 기본 모드에서 프레임을 순서대로 모두 넘기고, 링이 가득 차면 생산자가 기다리는지 테스트
+TEST(FrameQueueTest, DeliversFramesInOrderWithBackpressure) {
+    vv::FrameQueue queue(2);
+    std::thread producer([&queue] {
+        for (int i = 0; i < 10; i++) {
+            cv::Mat* slot = queue.beginWrite();
+            ASSERT_NE(slot, nullptr);
+            slot->create(4, 4, CV_8UC1);
+            slot->setTo(cv::Scalar(i));
+            queue.commitWrite(i % 2 ? vv::PixelFormat::Gray : vv::PixelFormat::BGR);
+        }
+        queue.close();
+    });
+    
+    cv::Mat frame;
+    vv::FrameQueue::FrameInfo info;
+    for (int i = 0; i < 10; i++) {
+        ASSERT_TRUE(queue.pop(frame, info));
+        EXPECT_EQ(frame.at<uchar>(3, 3), i);
+        EXPECT_EQ(info.format, i % 2 ? vv::PixelFormat::Gray : vv::PixelFormat::BGR);
+        EXPECT_EQ(info.droppedBefore, 0);
+    }
+    EXPECT_FALSE(queue.pop(frame, info));
+    producer.join();
+    EXPECT_GE(queue.meanOccupancy(), 1.0);
+    EXPECT_LE(queue.meanOccupancy(), 2.0);
+    
+    // 가득 찬 링에서 기다리던 생산자는 shutdown 으로 풀려남
+    vv::FrameQueue full(1);
+    full.beginWrite();
+    full.commitWrite(vv::PixelFormat::BGR);
+    std::thread blocked([&full] { EXPECT_EQ(full.beginWrite(), nullptr); });
+    full.shutdown();
+    blocked.join();
+}
+
+// 최신 프레임 모드에서 밀린 프레임을 버리고 가장 최근 프레임과 버린 수를 넘기는지 테스트
+TEST(FrameQueueTest, LatestFrameModeDropsStaleFrames) {
+    // 생산자는 기다리지 않고, 소비자는 가장 최근 프레임만 꺼내며 버린 수를 함께 받음
+    vv::FrameQueue queue(3, true);
+    auto produce = [&queue](int value) {
+        cv::Mat* slot = queue.beginWrite();
+        ASSERT_NE(slot, nullptr);
+        slot->create(2, 2, CV_8UC1);
+        slot->setTo(cv::Scalar(value));
+        queue.commitWrite(vv::PixelFormat::Gray);
+    };
+    for (int i = 0; i < 5; i++) {
+        produce(i);
+    }
+    EXPECT_EQ(queue.size(), 3u);
+    
+    cv::Mat frame;
+    vv::FrameQueue::FrameInfo info;
+    ASSERT_TRUE(queue.pop(frame, info));
+    EXPECT_EQ(frame.at<uchar>(0, 0), 4);
+    EXPECT_EQ(info.droppedBefore, 4);
+    EXPECT_LE(info.timestamp, vv::FrameQueue::Clock::now());
+    
+    produce(5);
+    ASSERT_TRUE(queue.pop(frame, info));
+    EXPECT_EQ(frame.at<uchar>(0, 0), 5);
+    EXPECT_EQ(info.droppedBefore, 0);
+    EXPECT_EQ(queue.droppedFrames(), 4);
+    EXPECT_EQ(queue.producerStalls(), 0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,7 +1,118 @@
 #include <gtest/gtest.h>
 #include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
+#include <opencv2/core/utility.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
 #include "visual_vertical/ImageProcessor.hpp"
+#include "visual_vertical/HOGKernel.hpp"
+
+namespace {
+
+// 전역 operator new 호출 횟수 (g_countAllocations 가 켜진 동안만 집계)
+std::atomic<bool> g_countAllocations{false};
+std::atomic<long> g_allocationCount{0};
+
+} // namespace
+
+// 힙 할당 횟수를 세는 전역 할당자 (new[]/delete[] 는 기본 구현이 아래 함수를 호출)
+void* operator new(std::size_t size) {
+    if (g_countAllocations.load(std::memory_order_relaxed)) {
+        g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+// 기존(다중 패스 float) computeHOG 구현을 그대로 옮긴 기준 히스토그램
+std::vector<float> computeReferenceHistogram(const cv::Mat& image, const vv::HOGParams& params) {
+    cv::Mat gray;
+    cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+    cv::GaussianBlur(gray, gray, cv::Size(params.blurKernelSize, params.blurKernelSize), params.blurSigma);
+    gray.convertTo(gray, CV_32F);
+    cv::normalize(gray, gray, 0, 1, cv::NORM_MINMAX);
+    
+    cv::Mat gx, gy;
+    cv::Sobel(gray, gx, CV_32F, 1, 0);
+    cv::Sobel(gray, gy, CV_32F, 0, 1);
+    gy = -gy;
+    
+    cv::Mat mag, ang;
+    cv::cartToPolar(gx, gy, mag, ang);
+    ang = ang * 180 / CV_PI;
+    cv::normalize(mag, mag, 0, 1, cv::NORM_MINMAX);
+    
+    cv::Mat magFilter;
+    cv::threshold(mag, magFilter, params.thresholdValue, 1, cv::THRESH_BINARY);
+    cv::Mat erodeKernel = cv::getStructuringElement(
+        cv::MORPH_RECT, cv::Size(params.erodeKernelSize, params.erodeKernelSize));
+    cv::erode(magFilter, magFilter, erodeKernel);
+    cv::normalize(magFilter, magFilter, 0, 1, cv::NORM_MINMAX);
+    
+    cv::Mat angMod;
+    cv::Mat mask = (ang == 360);
+    ang.copyTo(angMod);
+    angMod.setTo(0, mask);
+    mask = (ang >= 180);
+    cv::Mat temp = ang - 180;
+    temp.copyTo(angMod, mask);
+    
+    std::vector<float> hist(params.binCount, 0.0f);
+    for (int i = 0; i < angMod.rows; i++) {
+        for (int j = 0; j < angMod.cols; j++) {
+            int bin = static_cast<int>(angMod.at<float>(i, j));
+            if (bin >= 0 && bin < params.binCount) {
+                hist[bin] += magFilter.at<float>(i, j);
+            }
+        }
+    }
+    return hist;
+}
+
+// 이웃 빈(순환)까지 묶어서 비교한 상대 L1 오차
+// 기존 구현은 정확히 45/135/180도인 그래디언트가 float 반올림에 따라 인접 빈으로 갈리므로
+// 빈 단위 완전 일치 대신 ±1 빈 평활화 후의 차이를 본다
+double smoothedRelativeL1(const std::vector<float>& a, const std::vector<float>& b) {
+    const int n = static_cast<int>(a.size());
+    double diff = 0.0, total = 0.0;
+    for (int i = 0; i < n; i++) {
+        double sa = a[(i + n - 1) % n] + a[i] + a[(i + 1) % n];
+        double sb = b[(i + n - 1) % n] + b[i] + b[(i + 1) % n];
+        diff += std::abs(sa - sb);
+        total += sa;
+    }
+    return total > 0.0 ? diff / total : diff;
+}
+
+// 여러 방향의 줄무늬와 잡음이 섞인 640x360 테스트 영상
+cv::Mat createTexturedImage() {
+    cv::Mat image(360, 640, CV_8UC3, cv::Scalar(90, 90, 90));
+    cv::line(image, cv::Point(320, 0), cv::Point(320, 360), cv::Scalar(255, 255, 255), 6);
+    cv::line(image, cv::Point(100, 350), cv::Point(250, 50), cv::Scalar(20, 20, 20), 4);
+    cv::rectangle(image, cv::Point(420, 80), cv::Point(580, 300), cv::Scalar(200, 180, 160), cv::FILLED);
+    cv::Mat noise(image.size(), CV_8UC3);
+    cv::RNG rng(12345);
+    rng.fill(noise, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(24));
+    image += noise;
+    return image;
+}
+
+} // namespace
 
 // ImageProcessor 클래스 테스트
 class ImageProcessorTest : public ::testing::Test {
@@ -84,6 +195,501 @@ TEST_F(ImageProcessorTest, ComputeHOG) {
     EXPECT_TRUE(hasPositive);
 }
 
+// 스트리밍 HOG 커널이 기존 다중 패스 구현과 허용 오차(±1 빈 평활화 후 상대 L1 5%) 안에서 일치하는지 테스트
+TEST_F(ImageProcessorTest, FusedHistogramMatchesReference) {
+    vv::HOGParams params;
+    std::vector<cv::Mat> images = { testImage, createTexturedImage() };
+    
+    for (const auto& image : images) {
+        vv::ImageProcessor fusedProcessor(params);
+        std::vector<float> fused = fusedProcessor.computeHOG(image).histogram;
+        std::vector<float> reference = computeReferenceHistogram(image, params);
+        
+        ASSERT_EQ(fused.size(), reference.size());
+        EXPECT_LT(smoothedRelativeL1(fused, reference), 0.05);
+    }
+}
+
+// 첫 프레임 이후 같은 크기의 프레임에서는 computeHOG 가 힙 할당을 하지 않는지 테스트
+TEST_F(ImageProcessorTest, SteadyStateComputeHOGDoesNotAllocate) {
+    cv::Mat image = createTexturedImage();
+    vv::HOGResult result;
+    
+    // OpenCV 스레드 풀은 parallel_for_ 마다 자체 작업 객체를 할당하므로
+    // ImageProcessor 의 할당만 세도록 단일 스레드로 고정
+    cv::setNumThreads(1);
+    
+    // 첫 프레임에서 작업 버퍼와 결과 버퍼 크기 결정
+    processor->computeHOG(image, result);
+    
+    g_allocationCount = 0;
+    g_countAllocations = true;
+    for (int i = 0; i < 5; i++) {
+        processor->computeHOG(image, result);
+    }
+    g_countAllocations = false;
+    cv::setNumThreads(-1);
+    
+    EXPECT_EQ(g_allocationCount.load(), 0);
+    EXPECT_EQ(result.histogram.size(), 180);
+}
+
+// 스레드 수와 관계없이 타일별 부분 히스토그램 병합 결과가 비트 단위로 같은지 테스트
+TEST_F(ImageProcessorTest, HistogramIsIdenticalForAnyThreadCount) {
+    cv::Mat image = createTexturedImage();
+    
+    cv::setNumThreads(1);
+    vv::HOGResult single = processor->computeHOG(image);
+    
+    for (int threads : {2, 4, 8}) {
+        cv::setNumThreads(threads);
+        vv::ImageProcessor parallelProcessor;
+        vv::HOGResult parallel = parallelProcessor.computeHOG(image);
+        
+        EXPECT_EQ(parallel.histogram, single.histogram) << "threads=" << threads;
+        EXPECT_EQ(cv::norm(parallel.magnitudeFiltered, single.magnitudeFiltered, cv::NORM_INF), 0.0);
+    }
+    cv::setNumThreads(-1);
+}
+
+// 정수 방향 빈 계산이 정확한 각도의 정수부와 일치하는지 테스트 (빈 경계 근처 제외)
+TEST_F(ImageProcessorTest, IntegerOrientationBinMatchesExactAngle) {
+    for (int gx = -200; gx <= 200; gx += 3) {
+        for (int gy = -200; gy <= 200; gy += 3) {
+            if (gx == 0 && gy == 0) {
+                continue;
+            }
+            double deg = std::atan2(static_cast<double>(gy), static_cast<double>(gx)) * 180.0 / CV_PI;
+            if (deg < 0) {
+                deg += 180.0;
+            }
+            if (std::abs(deg - std::round(deg)) < 0.01) {
+                continue;
+            }
+            int expected = static_cast<int>(std::floor(deg)) % 180;
+            EXPECT_EQ(vv::kernel::orientationBinInt(gx, gy), expected) << "gx=" << gx << " gy=" << gy;
+        }
+    }
+}
+
+// LUT 방향 빈이 정수 방향 빈과 최대 1빈 이내로 같은지 테스트
+TEST_F(ImageProcessorTest, LookupOrientationBinWithinOneBin) {
+    const int maxG = vv::kernel::MAX_SOBEL_GRADIENT;
+    for (int gx = -maxG; gx <= maxG; gx += 7) {
+        for (int gy = -maxG; gy <= maxG; gy += 7) {
+            int diff = std::abs(vv::kernel::orientationBinLut(gx, gy) - vv::kernel::orientationBinInt(gx, gy));
+            EXPECT_TRUE(diff <= 1 || diff == 179) << "gx=" << gx << " gy=" << gy;
+        }
+    }
+    // 축 방향과 대각선은 정확히 경계 빈
+    EXPECT_EQ(vv::kernel::orientationBinLut(-5, 0), 0);
+    EXPECT_EQ(vv::kernel::orientationBinLut(0, -5), 90);
+    EXPECT_EQ(vv::kernel::orientationBinLut(-5, 5), 135);
+}
+
+// 정수/LUT 경로 히스토그램이 float 경로와 거의 같은지 테스트
+TEST_F(ImageProcessorTest, IntegerPrecisionsMatchFloatPath) {
+    std::vector<cv::Mat> images = { testImage, createTexturedImage() };
+    
+    for (vv::HOGPrecision precision : { vv::HOGPrecision::Integer, vv::HOGPrecision::Lookup }) {
+        vv::HOGParams intParams;
+        intParams.precision = precision;
+        vv::ImageProcessor intProcessor(intParams);
+        
+        for (const auto& image : images) {
+            std::vector<float> floatHist = processor->computeHOG(image).histogram;
+            std::vector<float> intHist = intProcessor.computeHOG(image).histogram;
+            
+            ASSERT_EQ(intHist.size(), floatHist.size());
+            EXPECT_LT(smoothedRelativeL1(intHist, floatHist), 0.02);
+        }
+    }
+}
+
+// 프레임 전체를 덮는 관심 영역은 관심 영역이 없을 때와 같은 결과인지 테스트
+TEST_F(ImageProcessorTest, RoiCoveringFrameMatchesFullFrame) {
+    cv::Mat image = createTexturedImage();
+    vv::HOGParams params;
+    params.roiRects.push_back(cv::Rect(-10, -10, image.cols + 20, image.rows + 20));
+    vv::ImageProcessor roiProcessor(params);
+    
+    vv::HOGResult full = processor->computeHOG(image);
+    vv::HOGResult roi = roiProcessor.computeHOG(image);
+    
+    EXPECT_EQ(roi.histogram, full.histogram);
+    EXPECT_EQ(cv::norm(roi.magnitudeFiltered, full.magnitudeFiltered, cv::NORM_INF), 0.0);
+}
+
+// 관심 영역 밖의 픽셀은 투표하지 않고, 같은 영역의 사각형과 마스크는 같은 결과인지 테스트
+TEST_F(ImageProcessorTest, RoiRestrictsHistogramToSelectedArea) {
+    cv::Mat image = createTexturedImage();
+    const cv::Rect area(0, 0, 300, 240);
+    
+    vv::HOGParams rectParams;
+    rectParams.roiRects.push_back(area);
+    vv::HOGResult rectResult = vv::ImageProcessor(rectParams).computeHOG(image);
+    
+    vv::HOGParams maskParams;
+    maskParams.roiMask = cv::Mat::zeros(image.size(), CV_8UC1);
+    maskParams.roiMask(area).setTo(255);
+    vv::HOGResult maskResult = vv::ImageProcessor(maskParams).computeHOG(image);
+    
+    EXPECT_EQ(rectResult.histogram, maskResult.histogram);
+    
+    // 관심 영역 밖은 침식 결과도 0
+    cv::Mat outside = rectResult.magnitudeFiltered.clone();
+    outside(area).setTo(0);
+    EXPECT_EQ(cv::countNonZero(outside), 0);
+    
+    double roiVotes = 0.0;
+    for (float v : rectResult.histogram) {
+        roiVotes += v;
+    }
+    EXPECT_GT(roiVotes, 0.0);
+    EXPECT_EQ(roiVotes, cv::countNonZero(rectResult.magnitudeFiltered(area)));
+}
+
+// 격자 샘플링이 전체 샘플링과 같은 주요 방향을 찾는지 테스트
+TEST_F(ImageProcessorTest, StridedSamplingKeepsDominantOrientation) {
+    cv::Mat image = createTexturedImage();
+    std::vector<float> full = processor->computeHOG(image).histogram;
+    auto dominant = [](const std::vector<float>& hist) {
+        return std::max_element(hist.begin() + 30, hist.begin() + 151) - hist.begin();
+    };
+    
+    for (int stride : { 2, 4 }) {
+        vv::HOGParams params;
+        params.samplingStride = stride;
+        vv::ImageProcessor sampledProcessor(params);
+        vv::HOGResult sampled = sampledProcessor.computeHOG(image);
+        
+        ASSERT_EQ(sampled.histogram.size(), full.size());
+        EXPECT_EQ(sampled.magnitudeFiltered.size(), image.size());
+        EXPECT_NEAR(dominant(sampled.histogram), dominant(full), 2) << "stride=" << stride;
+    }
+}
+
+// 시간적 모드가 바뀌지 않은 타일을 재사용하면서 전체 계산과 같은 히스토그램을 내는지 테스트
+TEST_F(ImageProcessorTest, TemporalModeReusesUnchangedTiles) {
+    cv::Mat image = createTexturedImage();
+    vv::HOGParams params;
+    params.temporal = true;
+    vv::ImageProcessor temporalProcessor(params);
+    vv::HOGResult result;
+    
+    temporalProcessor.computeHOG(image, result);
+    const int tileCount = temporalProcessor.recomputedTileCount();
+    EXPECT_EQ(result.histogram, processor->computeHOG(image).histogram);
+    
+    // 같은 프레임이면 다시 계산할 타일이 없음
+    temporalProcessor.computeHOG(image, result);
+    EXPECT_EQ(temporalProcessor.recomputedTileCount(), 0);
+    EXPECT_EQ(result.histogram, processor->computeHOG(image).histogram);
+    
+    // 아래쪽 일부만 바뀌면 그 주변 타일만 다시 계산
+    cv::Mat changed = image.clone();
+    cv::line(changed, cv::Point(20, 320), cv::Point(120, 350), cv::Scalar(60, 60, 60), 3);
+    temporalProcessor.computeHOG(changed, result);
+    EXPECT_GT(temporalProcessor.recomputedTileCount(), 0);
+    EXPECT_LT(temporalProcessor.recomputedTileCount(), tileCount);
+    EXPECT_LT(smoothedRelativeL1(result.histogram, processor->computeHOG(changed).histogram), 0.02);
+}
+
+// 렌더링 프레임만 디버그 영상을 요청해도 시간적 모드가 타일을 다시 계산하지 않고 할당도 없는지 테스트
+TEST_F(ImageProcessorTest, TemporalModeKeepsTilesAcrossOutputModes) {
+    cv::Mat image = createTexturedImage();
+    cv::Mat changed = image.clone();
+    cv::line(changed, cv::Point(20, 320), cv::Point(120, 350), cv::Scalar(60, 60, 60), 3);
+    vv::HOGParams params;
+    params.temporal = true;
+    vv::ImageProcessor temporalProcessor(params);
+    vv::HOGResult histogramResult, renderResult;
+
+    // 할당은 단일 스레드에서만 셈 (SteadyStateComputeHOGDoesNotAllocate 참고)
+    cv::setNumThreads(1);
+    temporalProcessor.computeHOG(image, renderResult, vv::HOGOutput::Full);
+    temporalProcessor.computeHOG(image, histogramResult, vv::HOGOutput::HistogramOnly);
+    EXPECT_EQ(temporalProcessor.recomputedTileCount(), 0);
+
+    // 출력 범위와 결과 객체를 번갈아 바꿔도 같은 프레임이면 다시 계산하는 타일도, 할당도 없음
+    int recomputed = 0;
+    g_allocationCount = 0;
+    g_countAllocations = true;
+    for (int i = 0; i < 4; i++) {
+        const bool render = i % 2 == 1;
+        temporalProcessor.computeHOG(image, render ? renderResult : histogramResult,
+                                     render ? vv::HOGOutput::Full : vv::HOGOutput::HistogramOnly);
+        recomputed += temporalProcessor.recomputedTileCount();
+    }
+    g_countAllocations = false;
+    EXPECT_EQ(g_allocationCount.load(), 0);
+    EXPECT_EQ(recomputed, 0);
+
+    // 히스토그램만 계산한 프레임에서 바뀐 타일은 다음 렌더링 프레임에서 디버그 영상만 다시 기록
+    temporalProcessor.computeHOG(changed, histogramResult, vv::HOGOutput::HistogramOnly);
+    EXPECT_GT(temporalProcessor.recomputedTileCount(), 0);
+    temporalProcessor.computeHOG(changed, renderResult, vv::HOGOutput::Full);
+    EXPECT_EQ(temporalProcessor.recomputedTileCount(), 0);
+    cv::setNumThreads(-1);
+
+    // 매 프레임 디버그 영상을 계산한 결과와 같음
+    vv::ImageProcessor reference(params);
+    vv::HOGResult expected;
+    reference.computeHOG(image, expected);
+    reference.computeHOG(changed, expected);
+    EXPECT_EQ(renderResult.histogram, expected.histogram);
+    EXPECT_EQ(histogramResult.histogram, expected.histogram);
+    EXPECT_EQ(cv::norm(renderResult.magnitude, expected.magnitude, cv::NORM_INF), 0.0);
+    EXPECT_EQ(cv::norm(renderResult.magnitudeFiltered, expected.magnitudeFiltered, cv::NORM_INF), 0.0);
+    EXPECT_EQ(cv::norm(renderResult.gradientX, expected.gradientX, cv::NORM_INF), 0.0);
+}
+
+// 반복 상자 블러가 가우시안에 가까운 히스토그램을 내고 관심 영역 경로와 일치하는지 테스트
+TEST_F(ImageProcessorTest, BoxBlurBackendApproximatesGaussian) {
+    cv::Mat image = createTexturedImage();
+    std::vector<float> gaussian = processor->computeHOG(image).histogram;
+    
+    vv::HOGParams params;
+    params.blurBackend = vv::BlurBackend::Box;
+    vv::ImageProcessor boxProcessor(params);
+    std::vector<float> box = boxProcessor.computeHOG(image).histogram;
+    ASSERT_EQ(box.size(), gaussian.size());
+    EXPECT_LT(smoothedRelativeL1(box, gaussian), 0.25);
+    EXPECT_NEAR(std::max_element(box.begin() + 30, box.begin() + 151) - box.begin(),
+                std::max_element(gaussian.begin() + 30, gaussian.begin() + 151) - gaussian.begin(), 2);
+    
+    // 상자 반지름 합은 커널 크기와 무관한 비용으로 sigma 를 근사
+    std::vector<int> radii = vv::kernel::boxBlurRadii(params.blurKernelSize, params.blurSigma, 3);
+    double variance = 0.0;
+    for (int r : radii) {
+        variance += ((2.0 * r + 1) * (2.0 * r + 1) - 1) / 12.0;
+    }
+    EXPECT_NEAR(std::sqrt(variance), params.blurSigma, 0.5);
+    
+    params.roiRects.push_back(cv::Rect(0, 0, image.cols, image.rows));
+    vv::ImageProcessor roiProcessor(params);
+    EXPECT_EQ(roiProcessor.computeHOG(image).histogram, box);
+}
+
+// 특화된 행 커널이 범용 커널과 비트 단위로 같은 결과를 내는지 테스트
+TEST_F(ImageProcessorTest, SpecializedKernelsMatchGeneric) {
+    EXPECT_FALSE(vv::kernel::selectKernels(180, 13, 3).specialized);
+    
+    cv::RNG rng(7);
+    const int cols = 97;
+    for (int erodeSize : { 3, 5 }) {
+        const vv::kernel::KernelTable& fixed = vv::kernel::selectKernels(180, 11, erodeSize);
+        ASSERT_TRUE(fixed.specialized);
+        std::vector<uint16_t> taps = vv::kernel::gaussianKernelFixedPoint(11, 3.0);
+        
+        // 가로/세로 블러
+        std::vector<uint8_t> gray(cols);
+        for (uint8_t& v : gray) {
+            v = static_cast<uint8_t>(rng.uniform(0, 256));
+        }
+        std::vector<uint16_t> expectedH(cols), actualH(cols);
+        for (int xBegin : { 0, 3, 40 }) {
+            vv::kernel::blurRowH(gray.data(), cols, xBegin, cols - xBegin / 2, taps.data(), 11, expectedH.data());
+            fixed.blurRowH(gray.data(), cols, xBegin, cols - xBegin / 2, taps.data(), 11, actualH.data());
+            EXPECT_TRUE(std::equal(expectedH.begin() + xBegin, expectedH.end() - xBegin / 2, actualH.begin() + xBegin));
+        }
+        std::vector<std::vector<uint16_t>> rows(11, std::vector<uint16_t>(cols));
+        std::vector<const uint16_t*> window;
+        for (std::vector<uint16_t>& row : rows) {
+            for (uint16_t& v : row) {
+                v = static_cast<uint16_t>(rng.uniform(0, 256 * 256));
+            }
+            window.push_back(row.data());
+        }
+        std::vector<uint8_t> expectedV(cols), actualV(cols);
+        vv::kernel::blurRowV(window.data(), cols, taps.data(), 11, expectedV.data());
+        fixed.blurRowV(window.data(), cols, taps.data(), 11, actualV.data());
+        EXPECT_EQ(expectedV, actualV);
+        
+        // 비트 마스크 침식 (영상 경계에서 줄어든 창과 워드 경계에 걸친 범위 포함) 이 바이트 침식과 같은지
+        const int maskCols = 203;
+        const int words = vv::kernel::maskWords(maskCols);
+        std::vector<std::vector<uint8_t>> masks(erodeSize, std::vector<uint8_t>(maskCols));
+        std::vector<std::vector<uint64_t>> packed(erodeSize, std::vector<uint64_t>(words));
+        std::vector<const uint8_t*> maskWindow;
+        std::vector<const uint64_t*> bitWindow;
+        for (int i = 0; i < erodeSize; i++) {
+            for (uint8_t& v : masks[i]) {
+                v = rng.uniform(0, 8) != 0;
+            }
+            vv::kernel::packMaskRow(masks[i].data(), maskCols, 0, maskCols, packed[i].data());
+            maskWindow.push_back(masks[i].data());
+            bitWindow.push_back(packed[i].data());
+        }
+        std::vector<uint8_t> tmp(maskCols), expectedE(maskCols);
+        std::vector<uint64_t> bitTmp(words), genericE(words), actualE(words);
+        for (int rowCount : { erodeSize, erodeSize - 1 }) {
+            for (std::pair<int, int> range : { std::make_pair(0, maskCols), std::make_pair(5, 190), std::make_pair(64, 128) }) {
+                vv::kernel::erodeRow(maskWindow.data(), rowCount, maskCols, range.first, range.second, erodeSize,
+                                     tmp.data(), expectedE.data());
+                vv::kernel::erodeBitsRow(bitWindow.data(), rowCount, maskCols, range.first, range.second, erodeSize,
+                                         bitTmp.data(), genericE.data());
+                fixed.erodeBitsRow(bitWindow.data(), rowCount, maskCols, range.first, range.second, erodeSize,
+                                   bitTmp.data(), actualE.data());
+                for (int x = range.first; x < range.second; x++) {
+                    EXPECT_EQ((genericE[x / 64] >> (x % 64)) & 1, expectedE[x]) << "x=" << x;
+                    EXPECT_EQ((actualE[x / 64] >> (x % 64)) & 1, expectedE[x]) << "x=" << x;
+                }
+            }
+        }
+        
+        // 히스토그램 누적 (바이트 마스크와 비트 마스크)
+        vv::kernel::erodeRow(maskWindow.data(), erodeSize, maskCols, 0, maskCols, erodeSize, tmp.data(), expectedE.data());
+        vv::kernel::erodeBitsRow(bitWindow.data(), erodeSize, maskCols, 0, maskCols, erodeSize, bitTmp.data(), genericE.data());
+        std::vector<uint8_t> bins(maskCols);
+        for (uint8_t& v : bins) {
+            v = static_cast<uint8_t>(rng.uniform(0, 181));
+        }
+        std::vector<uint32_t> expectedHist(181, 0), actualHist(181 * vv::kernel::HIST_LANES, 0);
+        std::vector<uint32_t> bitHist(181 * vv::kernel::HIST_LANES, 0);
+        int expectedVotes = vv::kernel::accumulateRow(expectedE.data(), bins.data(), maskCols, 180, expectedHist.data());
+        int actualVotes = fixed.accumulateRow(expectedE.data(), bins.data(), maskCols, 180, actualHist.data());
+        int bitVotes = vv::kernel::accumulateBitsRow(genericE.data(), 0, maskCols, bins.data(), 180, bitHist.data());
+        vv::kernel::foldHistLanes(actualHist.data(), 180);
+        vv::kernel::foldHistLanes(bitHist.data(), 180);
+        EXPECT_EQ(expectedVotes, actualVotes);
+        EXPECT_EQ(expectedVotes, bitVotes);
+        EXPECT_TRUE(std::equal(expectedHist.begin(), expectedHist.begin() + 180, actualHist.begin()));
+        EXPECT_TRUE(std::equal(expectedHist.begin(), expectedHist.begin() + 180, bitHist.begin()));
+    }
+}
+
+// CPU 가 지원하는 모든 SIMD 변형이 스칼라 커널과 같은 히스토그램을 내는지 테스트
+TEST_F(ImageProcessorTest, SimdLevelsMatchScalar) {
+    cv::Mat image = createTexturedImage();
+    const vv::kernel::SimdLevel active = vv::kernel::activeSimdLevel();
+    
+    for (vv::HOGPrecision precision : { vv::HOGPrecision::Float, vv::HOGPrecision::Integer, vv::HOGPrecision::Lookup }) {
+        vv::HOGParams params;
+        params.precision = precision;
+        ASSERT_TRUE(vv::kernel::setSimdLevel(vv::kernel::SimdLevel::Scalar));
+        vv::ImageProcessor scalarProcessor(params);
+        std::vector<float> expected = scalarProcessor.computeHOG(image).histogram;
+        
+        for (vv::kernel::SimdLevel level : { vv::kernel::SimdLevel::SSE42, vv::kernel::SimdLevel::AVX2,
+                                             vv::kernel::SimdLevel::AVX512 }) {
+            if (!vv::kernel::setSimdLevel(level)) {
+                continue;
+            }
+            vv::ImageProcessor simdProcessor(params);
+            EXPECT_EQ(simdProcessor.computeHOG(image).histogram, expected) << vv::kernel::simdLevelName(level);
+        }
+    }
+    vv::kernel::setSimdLevel(active);
+}
+
+// 단일 채널 휘도와 NV12/I420 프레임이 같은 휘도의 BGR 입력과 같은 결과를 내는지 테스트
+TEST_F(ImageProcessorTest, LumaAndYuvInputMatchBgr) {
+    cv::Mat gray;
+    cv::cvtColor(createTexturedImage(), gray, cv::COLOR_BGR2GRAY);
+    cv::Mat bgr;
+    cv::cvtColor(gray, bgr, cv::COLOR_GRAY2BGR);
+    std::vector<float> expected = processor->computeHOG(bgr).histogram;
+    
+    vv::ImageProcessor lumaProcessor;
+    EXPECT_EQ(lumaProcessor.computeHOG(gray).histogram, expected);
+    
+    // Y 평면 아래에 색차 평면 (임의 값) 을 붙인 4:2:0 프레임
+    cv::Mat yuv(gray.rows * 3 / 2, gray.cols, CV_8UC1, cv::Scalar(77));
+    gray.copyTo(yuv.rowRange(0, gray.rows));
+    for (vv::PixelFormat format : { vv::PixelFormat::NV12, vv::PixelFormat::I420 }) {
+        vv::HOGResult result;
+        lumaProcessor.computeHOG(yuv, format, result);
+        EXPECT_EQ(result.magnitudeFiltered.size(), gray.size());
+        EXPECT_EQ(result.histogram, expected);
+    }
+}
+
+// 히스토그램 전용 출력이 디버그 영상 없이 같은 히스토그램을 내는지 테스트
+TEST_F(ImageProcessorTest, HistogramOnlyOutputSkipsDebugPlanes) {
+    cv::Mat image = createTexturedImage();
+    vv::HOGResult full = processor->computeHOG(image);
+    
+    for (int stride : { 1, 2 }) {
+        vv::HOGParams params;
+        params.samplingStride = stride;
+        vv::ImageProcessor fullProcessor(params);
+        vv::ImageProcessor histogramProcessor(params);
+        vv::HOGResult expected = fullProcessor.computeHOG(image);
+        
+        // 이전 프레임의 디버그 영상이 남아 있는 결과도 해제
+        vv::HOGResult result = full;
+        histogramProcessor.computeHOG(image, result, vv::HOGOutput::HistogramOnly);
+        EXPECT_EQ(result.histogram, expected.histogram) << "stride=" << stride;
+        EXPECT_TRUE(result.gradientX.empty());
+        EXPECT_TRUE(result.gradientY.empty());
+        EXPECT_TRUE(result.magnitude.empty());
+        EXPECT_TRUE(result.magnitudeFiltered.empty());
+    }
+}
+
+// 2단계 히스토그램: 거친 빈은 전체 히스토그램의 구간 합, 세밀 히스토그램은 피크 주변 창 안에서만 전체와 같은지 테스트
+TEST_F(ImageProcessorTest, CoarseToFineHistogramMatchesFullInsideWindow) {
+    cv::Mat image = createTexturedImage();
+    vv::HOGResult full = processor->computeHOG(image);
+    ASSERT_TRUE(full.coarseHistogram.empty());
+    
+    vv::HOGParams params;
+    params.coarseBinWidth = 5;
+    params.refineRadius = 10;
+    vv::ImageProcessor twoLevel(params);
+    vv::HOGResult result;
+    twoLevel.computeHOG(image, result, vv::HOGOutput::HistogramOnly);
+    ASSERT_EQ(result.coarseHistogram.size(), 36u);
+    ASSERT_EQ(result.histogram.size(), full.histogram.size());
+    
+    // 30 ~ 150도와 겹치는 거친 빈 중 최대 빈이 창의 중심
+    int peak = 6;
+    for (int b = 6; b <= 30; b++) {
+        float sum = 0.0f;
+        for (int i = b * 5; i < b * 5 + 5; i++) {
+            sum += full.histogram[i];
+        }
+        EXPECT_EQ(result.coarseHistogram[b], sum) << "coarse bin " << b;
+        if (result.coarseHistogram[b] > result.coarseHistogram[peak]) {
+            peak = b;
+        }
+    }
+    for (int i = 0; i < 180; i++) {
+        const bool inside = i >= peak * 5 - 10 && i < peak * 5 + 15;
+        EXPECT_EQ(result.histogram[i], inside ? full.histogram[i] : 0.0f) << "bin " << i;
+    }
+}
+
+// 시각화의 모든 패널이 하나의 캔버스에 바로 그려지고 프레임 간에 캔버스를 재사용하는지 테스트
+TEST_F(ImageProcessorTest, VisualizationComposesIntoSingleCanvas) {
+    vv::HOGResult hogResult = processor->computeHOG(testImage);
+    vv::VVResult vvResult;
+    cv::Mat histogram(60, 2 * testImage.cols, CV_8UC3, cv::Scalar(10, 20, 30));
+    
+    // 보정 패널에 바로 회전하면 캔버스의 해당 영역이 곧 보정 이미지
+    cv::Mat calibrated = processor->calibratedPanel(testImage.size(), histogram.rows);
+    processor->rotateImage(testImage, 0, calibrated);
+    cv::Mat expectedCalibrated = calibrated.clone();
+    
+    cv::Mat canvas = processor->createVisualization(testImage, calibrated, hogResult, vvResult, histogram);
+    ASSERT_EQ(canvas.size(), cv::Size(2 * testImage.cols, 2 * testImage.rows + histogram.rows));
+    EXPECT_EQ(calibrated.data, canvas.ptr(0) + 3 * testImage.cols);
+    
+    // 수평선 아래 영역은 회전 결과 그대로, 매그니튜드와 히스토그램은 해당 패널에 그대로 기록
+    const cv::Rect belowLine(0, testImage.rows / 2 + 3, testImage.cols, testImage.rows / 2 - 3);
+    EXPECT_EQ(cv::norm(calibrated(belowLine), expectedCalibrated(belowLine), cv::NORM_INF), 0.0);
+    cv::Mat magnitude8U, magnitudeBGR;
+    hogResult.magnitude.convertTo(magnitude8U, CV_8U, 255);
+    cv::cvtColor(magnitude8U, magnitudeBGR, cv::COLOR_GRAY2BGR);
+    EXPECT_EQ(cv::norm(canvas(cv::Rect(0, testImage.rows, testImage.cols, testImage.rows)), magnitudeBGR, cv::NORM_INF), 0.0);
+    EXPECT_EQ(cv::norm(canvas.rowRange(2 * testImage.rows, canvas.rows), histogram, cv::NORM_INF), 0.0);
+    
+    // 크기가 같으면 다음 프레임도 같은 캔버스를 재사용
+    cv::Mat again = processor->createVisualization(testImage, calibrated, hogResult, vvResult, histogram);
+    EXPECT_EQ(again.data, canvas.data);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <string>
+#include <opencv2/core.hpp>
+#include <opencv2/videoio.hpp>
+#include "visual_vertical/IOHandler.hpp"
+
+// 카메라 캡처 설정은 파일 입력에 적용되지 않고 파일이 자동 선택 백엔드로 열리는지 테스트
+TEST(IOHandlerTest, CaptureBackendSettingsFallBackToFileInput) {
+    // v4l2loopback 장치 없이: 카메라 백엔드 설정은 파일 입력에 적용되지 않고 자동 선택으로 열림
+    const std::string path = (std::filesystem::temp_directory_path() / "vv_capture_backend_test.avi").string();
+    {
+        cv::VideoWriter writer(path, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'), 30.0, cv::Size(64, 48));
+        if (!writer.isOpened()) {
+            GTEST_SKIP() << "MJPG video writer is not available";
+        }
+        for (int i = 0; i < 5; i++) {
+            writer.write(cv::Mat(48, 64, CV_8UC3, cv::Scalar::all(40 * i)));
+        }
+    }
+    
+    vv::Config config;
+    config.inputFilePath = path;
+    config.captureBackend = vv::CaptureBackend::V4L2;
+    config.captureFourcc = "YUYV";
+    config.captureBuffers = 1;
+    vv::IOHandler ioHandler(config);
+    EXPECT_LT(ioHandler.getStartupLatencyMs(), 0.0);
+    ASSERT_TRUE(ioHandler.openVideoSource());
+    EXPECT_EQ(ioHandler.getCaptureApi(), cv::CAP_ANY);
+    
+    cv::Mat frame;
+    int frames = 0;
+    while (ioHandler.readNextFrame(frame)) {
+        EXPECT_EQ(frame.size(), cv::Size(64, 48));
+        EXPECT_EQ(ioHandler.getDroppedFrames(), 0);
+        frames++;
+    }
+    EXPECT_EQ(frames, 5);
+    EXPECT_GE(ioHandler.getStartupLatencyMs(), 0.0);
+    std::filesystem::remove(path);
+}
+
+// 캡처 백엔드 설정이 해당하는 OpenCV 캡처 API 로 바뀌는지 테스트
+TEST(IOHandlerTest, CaptureBackendMapsToOpenCvApi) {
+    EXPECT_EQ(vv::IOHandler::captureApi(vv::CaptureBackend::Auto), cv::CAP_ANY);
+    EXPECT_EQ(vv::IOHandler::captureApi(vv::CaptureBackend::V4L2), cv::CAP_V4L2);
+    EXPECT_EQ(vv::IOHandler::captureApi(vv::CaptureBackend::DShow), cv::CAP_DSHOW);
+    EXPECT_EQ(vv::IOHandler::captureApi(vv::CaptureBackend::MSMF), cv::CAP_MSMF);
+}
+
+// 지정한 백엔드로 카메라를 열 수 없으면 자동 선택으로 다시 시도하는지 테스트
+TEST(IOHandlerTest, UnavailableCameraBackendFallsBackToAutomaticSelection) {
+    vv::Config config;
+    config.useCamera = true;
+    config.cameraPort = 9999; // 존재하지 않는 장치
+    config.captureBackend = vv::CaptureBackend::V4L2;
+    vv::IOHandler ioHandler(config);
+    EXPECT_FALSE(ioHandler.openVideoSource());
+    EXPECT_EQ(ioHandler.getCaptureApi(), cv::CAP_ANY);
+    EXPECT_LT(ioHandler.getStartupLatencyMs(), 0.0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <vector>
+#include <opencv2/core.hpp>
+#include "visual_vertical/RenderThread.hpp"
+
+// 렌더링 스레드가 추정 루프를 기다리게 하지 않고 최신 스냅샷만 그리는지 테스트
+TEST(RenderThreadTest, PostNeverWaitsAndRendersLatest) {
+    // 첫 렌더링을 붙잡아 둔 동안에도 post 는 반환되고, 밀린 스냅샷은 최신 것만 남음
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::vector<double> rendered;
+    vv::RenderThread renderer([&](const vv::RenderSnapshot& snapshot) {
+        released.wait();
+        rendered.push_back(snapshot.vv.angle);
+        return cv::Mat(4, 4, CV_8UC3, cv::Scalar::all(snapshot.vv.angle));
+    }, 0.0, 3);
+    
+    std::vector<bool> due;
+    for (int i = 0; i < 6; i++) {
+        due.push_back(renderer.frameDue());
+    }
+    EXPECT_EQ(due, (std::vector<bool>{ true, false, false, true, false, false }));
+    
+    renderer.start();
+    cv::Mat frame(8, 8, CV_8UC3, cv::Scalar::all(0));
+    vv::HOGResult hog;
+    vv::VVResult result;
+    for (int i = 0; i < 5; i++) {
+        result.angle = i;
+        renderer.post(frame, hog, result, 0.0f);
+    }
+    release.set_value();
+    renderer.stop();
+    
+    ASSERT_FALSE(rendered.empty());
+    EXPECT_LE(rendered.size(), 2u);
+    EXPECT_DOUBLE_EQ(rendered.back(), 4.0);
+    EXPECT_EQ(renderer.renderedCount(), static_cast<long long>(rendered.size()));
+    EXPECT_EQ(renderer.droppedCount(), 5 - renderer.renderedCount());
+    
+    // 주 스레드는 가장 최근에 합성한 캔버스를 한 번만 가져감
+    cv::Mat canvas;
+    ASSERT_TRUE(renderer.takeDisplayFrame(canvas));
+    EXPECT_EQ(canvas.size(), cv::Size(4, 4));
+    EXPECT_EQ(canvas.at<uchar>(0, 0), 4);
+    EXPECT_FALSE(renderer.takeDisplayFrame(canvas));
+}
+
+// 녹화 중에는 렌더링이 밀려도 스냅샷을 버리지 않고, 건너뛴 프레임 자리에는 직전 캔버스를 다시 기록하는지 테스트
+TEST(RenderThreadTest, RecordingKeepsEverySnapshotInOrder) {
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::vector<int> recorded;
+    vv::RenderThread renderer([&](const vv::RenderSnapshot& snapshot) {
+        released.wait();
+        return cv::Mat(4, 4, CV_8UC3, cv::Scalar::all(snapshot.vv.angle));
+    }, 0.0, 1, [&](const cv::Mat& canvas) {
+        recorded.push_back(canvas.at<uchar>(0, 0));
+    }, 2);
+    
+    // 첫 렌더링을 붙잡아 둔 동안 큐 (길이 2) 를 넘겨 넣으면 post 는 자리가 날 때까지 기다림
+    renderer.start();
+    cv::Mat frame(8, 8, CV_8UC3, cv::Scalar::all(0));
+    vv::HOGResult hog;
+    vv::VVResult result;
+    std::future<void> producer = std::async(std::launch::async, [&] {
+        for (int i = 1; i <= 4; i++) {
+            result.angle = i;
+            renderer.post(frame, hog, result, 0.0f);
+            if (i == 2) {
+                renderer.postRepeat();
+            }
+        }
+    });
+    EXPECT_EQ(producer.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+    release.set_value();
+    producer.wait();
+    renderer.stop();
+    
+    EXPECT_EQ(recorded, (std::vector<int>{ 1, 2, 2, 3, 4 }));
+    EXPECT_EQ(renderer.renderedCount(), 4);
+    EXPECT_EQ(renderer.droppedCount(), 0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
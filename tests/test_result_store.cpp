@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "visual_vertical/ResultStore.hpp"
+
+// 비움 콜백이 있으면 가득 찰 때마다 순서대로 일괄 전달, 없으면 최근 결과만 유지
+TEST(ResultStoreTest, DrainsInBatchesOrOverwritesOldest) {
+    std::vector<double> drained;
+    std::vector<size_t> batches;
+    vv::ResultStore store(4, [&](const vv::VVResult* results, size_t count) {
+        batches.push_back(count);
+        for (size_t i = 0; i < count; i++) {
+            drained.push_back(results[i].angle);
+        }
+    });
+    vv::VVResult result;
+    for (int i = 0; i < 10; i++) {
+        result.angle = i;
+        store.push(result);
+    }
+    EXPECT_EQ(batches, (std::vector<size_t>{ 4, 4 }));
+    EXPECT_EQ(store.size(), 2u);
+    EXPECT_DOUBLE_EQ(store.latest().angle, 9.0);
+    store.flush();
+    EXPECT_EQ(store.size(), 0u);
+    ASSERT_EQ(drained.size(), 10u);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_DOUBLE_EQ(drained[i], i);
+    }
+    
+    vv::ResultStore recent(3);
+    for (int i = 0; i < 7; i++) {
+        result.angle = i;
+        recent.push(result);
+    }
+    ASSERT_EQ(recent.size(), 3u);
+    EXPECT_DOUBLE_EQ(recent[0].angle, 4.0);
+    EXPECT_DOUBLE_EQ(recent[2].angle, 6.0);
+    EXPECT_EQ(recent.totalCount(), 7u);
+    EXPECT_EQ(recent.droppedCount(), 4u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
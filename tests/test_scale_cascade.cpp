@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <vector>
+#include "visual_vertical/ImageProcessor.hpp"
+#include "visual_vertical/ScaleCascade.hpp"
+#include "visual_vertical/VVEstimator.hpp"
+
+namespace {
+
+// 여러 방향의 줄무늬와 잡음이 섞인 640x360 테스트 영상
+cv::Mat createTexturedImage() {
+    cv::Mat image(360, 640, CV_8UC3, cv::Scalar(90, 90, 90));
+    cv::line(image, cv::Point(320, 0), cv::Point(320, 360), cv::Scalar(255, 255, 255), 6);
+    cv::line(image, cv::Point(100, 350), cv::Point(250, 50), cv::Scalar(20, 20, 20), 4);
+    cv::rectangle(image, cv::Point(420, 80), cv::Point(580, 300), cv::Scalar(200, 180, 160), cv::FILLED);
+    cv::Mat noise(image.size(), CV_8UC3);
+    cv::RNG rng(12345);
+    rng.fill(noise, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(24));
+    image += noise;
+    return image;
+}
+
+} // namespace
+
+// 신뢰도가 기준 이상이면 가장 거친 단계에서 멈추고, 아니면 가장 세밀한 단계까지 내려가는지 테스트
+TEST(ScaleCascadeTest, RefinesOnlyWhenUnconfident) {
+    cv::Mat image = createTexturedImage();
+    cv::Mat half, quarter;
+    cv::pyrDown(image, half);
+    cv::pyrDown(half, quarter);
+    vv::HOGResult coarseExpected = vv::ImageProcessor().computeHOG(quarter);
+    vv::HOGResult fineExpected = vv::ImageProcessor().computeHOG(image);
+    
+    vv::HOGResult result;
+    vv::ScaleCascade accepting(vv::HOGParams(), { 0, 2 }, 0.0);
+    EXPECT_EQ(accepting.levels(), (std::vector<int>{ 2, 0 }));
+    EXPECT_EQ(accepting.computeHOG(image, result, vv::HOGOutput::HistogramOnly), 2);
+    EXPECT_EQ(result.histogram, coarseExpected.histogram);
+    EXPECT_DOUBLE_EQ(accepting.confidence(), vv::VVEstimator::peakConfidence(coarseExpected.histogram));
+    
+    vv::ScaleCascade refining(vv::HOGParams(), { 2, 0 }, 1.1);
+    EXPECT_EQ(refining.computeHOG(image, result), 0);
+    EXPECT_EQ(result.histogram, fineExpected.histogram);
+    EXPECT_EQ(result.magnitudeFiltered.size(), image.size());
+}
+
+// 2단계 히스토그램이면 거친 히스토그램으로 신뢰도를 계산해 잡음 영상에서 세밀한 단계로 내려가는지 테스트
+TEST(ScaleCascadeTest, DescendsOnLowTextureWithCoarseBins) {
+    cv::Mat image(360, 640, CV_8UC3, cv::Scalar(90, 90, 90));
+    cv::Mat noise(image.size(), CV_8UC3);
+    cv::RNG rng(12345);
+    rng.fill(noise, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(24));
+    image += noise;
+
+    vv::HOGParams params;
+    params.coarseBinWidth = 5;
+    params.refineRadius = 10;
+    const double threshold = 0.5;
+
+    // 가장 거친 단계만: 세밀 히스토그램으로 재면 창 안에 가중치가 몰려 기준을 넘음
+    vv::HOGResult result;
+    vv::ScaleCascade coarseOnly(params, { 2 }, threshold);
+    coarseOnly.computeHOG(image, result, vv::HOGOutput::HistogramOnly);
+    ASSERT_EQ(result.coarseBinWidth, 5);
+    EXPECT_GT(vv::VVEstimator::peakConfidence(result.histogram), threshold);
+    EXPECT_LT(coarseOnly.confidence(), threshold);
+    EXPECT_DOUBLE_EQ(coarseOnly.confidence(), vv::VVEstimator::peakConfidence(result.coarseHistogram, 5));
+
+    vv::ScaleCascade cascade(params, { 2, 0 }, threshold);
+    EXPECT_EQ(cascade.computeHOG(image, result, vv::HOGOutput::HistogramOnly), 0);
+
+    // 추정 결과의 신뢰도도 거친 히스토그램 기준
+    vv::VVEstimator estimator;
+    EXPECT_DOUBLE_EQ(estimator.estimateVV(result, vv::VVResult()).confidence, vv::VVEstimator::peakConfidence(result));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
 #include "visual_vertical/VVEstimator.hpp"
+#include "visual_vertical/utils/Helpers.hpp"
 
 // VVEstimator 클래스 테스트
 class VVEstimatorTest : public ::testing::Test {
@@ -67,6 +71,143 @@ TEST_F(VVEstimatorTest, EstimateVVMultiplePeaks) {
     EXPECT_NEAR(result.angle, expectedAngle, 0.1);
 }
 
+// 이전 구현 (정렬 기반 상위 3개 선택) 과 같은 결과를 내는지 무작위 히스토그램으로 검사
+TEST_F(VVEstimatorTest, EstimateVVMatchesSortedTopThree) {
+    auto reference = [](const std::vector<float>& histogram, const vv::VVResult& previous) {
+        std::vector<int> indices;
+        for (int i = 30; i <= 150 && i < static_cast<int>(histogram.size()); i++) {
+            indices.push_back(i);
+        }
+        if (indices.empty()) {
+            return previous.angle;
+        }
+        const int n = std::min(3, static_cast<int>(indices.size()));
+        std::partial_sort(indices.begin(), indices.begin() + n, indices.end(),
+                          [&histogram](int i1, int i2) { return histogram[i1] > histogram[i2]; });
+        double sumWeights = 0.0;
+        double sumWeightedAngles = 0.0;
+        for (int i = 0; i < n; i++) {
+            sumWeights += histogram[indices[i]];
+            sumWeightedAngles += indices[i] * static_cast<double>(histogram[indices[i]]);
+        }
+        double angle = sumWeights > 0 ? sumWeightedAngles / sumWeights : previous.angle;
+        return 0.7 * angle + (1.0 - 0.7) * previous.angle;
+    };
+    
+    // 실제 HOG 히스토그램은 정수 투표 수라 같은 값이 흔하므로 작은 정수 값으로 동점도 검사
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> value(0.0f, 1.0f);
+    std::uniform_int_distribution<int> votes(0, 20);
+    vv::VVResult previous;
+    previous.angle = 90.0;
+    for (bool integer : { false, true }) {
+        for (int size : { 180, 181, 100, 32, 20 }) {
+            for (int trial = 0; trial < 500; trial++) {
+                std::vector<float> histogram(size);
+                for (float& v : histogram) {
+                    v = integer ? static_cast<float>(votes(rng)) : value(rng);
+                }
+                vv::VVResult result = estimator->estimateVV(histogram, previous);
+                EXPECT_EQ(result.angle, reference(histogram, previous)) << "size=" << size << " integer=" << integer;
+                previous = result;
+            }
+        }
+    }
+}
+
+// 같은 값의 피크는 std::partial_sort 와 같은 인덱스를 같은 순서로 선택
+TEST_F(VVEstimatorTest, ArgmaxTopNBreaksTiesLikePartialSort) {
+    auto reference = [](const std::vector<float>& histogram, int n, int begin, int end) {
+        std::vector<int> indices(end - begin);
+        std::iota(indices.begin(), indices.end(), begin);
+        n = std::min(n, static_cast<int>(indices.size()));
+        std::partial_sort(indices.begin(), indices.begin() + n, indices.end(),
+                          [&histogram](int i1, int i2) { return histogram[i1] > histogram[i2]; });
+        indices.resize(n);
+        return indices;
+    };
+    
+    std::vector<float> histogram(180, 0.0f);
+    histogram[40] = histogram[70] = histogram[100] = histogram[130] = 0.5f;
+    histogram[10] = histogram[160] = 1.0f;
+    
+    std::array<int, 3> top;
+    ASSERT_EQ(vv::utils::argmaxTopN<3>(histogram.data(), 30, 151, top), 3);
+    EXPECT_EQ(std::vector<int>(top.begin(), top.end()), reference(histogram, 3, 30, 151));
+    
+    std::array<int, 3> few;
+    ASSERT_EQ(vv::utils::argmaxTopN<3>(histogram.data(), 69, 71, few), 2);
+    EXPECT_EQ(std::vector<int>(few.begin(), few.begin() + 2), reference(histogram, 3, 69, 71));
+    EXPECT_EQ(vv::utils::argmaxTopN<3>(histogram.data(), 30, 30, few), 0);
+    
+    // 실행 시간 개수를 받는 argmaxN 도 같은 선택
+    for (int n : { 1, 3, 5 }) {
+        EXPECT_EQ(vv::utils::argmaxN(histogram, n, 30, 151), reference(histogram, n, 30, 151)) << "n=" << n;
+    }
+}
+
+// 피크 선명도는 한 방향에 몰린 히스토그램일수록 1 에 가까움
+TEST_F(VVEstimatorTest, PeakConfidenceMeasuresSharpness) {
+    // 평평하면 최대 빈은 범위 시작 (30도) 이므로 30 ~ 35도의 6 빈만 피크 주변
+    std::vector<float> flat(180, 1.0f);
+    EXPECT_NEAR(vv::VVEstimator::peakConfidence(flat), 6.0 / 121.0, 1e-9);
+    
+    std::vector<float> sharp(180, 0.0f);
+    sharp[90] = 1.0f;
+    sharp[93] = 0.5f;
+    sharp[20] = 5.0f; // 범위 밖은 무시
+    EXPECT_DOUBLE_EQ(vv::VVEstimator::peakConfidence(sharp), 1.0);
+    
+    sharp[120] = 1.5f;
+    EXPECT_DOUBLE_EQ(vv::VVEstimator::peakConfidence(sharp), 0.5);
+    EXPECT_DOUBLE_EQ(vv::VVEstimator::peakConfidence(std::vector<float>(180, 0.0f)), 0.0);
+    
+    vv::VVResult result = estimator->estimateVV(sharp, vv::VVResult(), 2);
+    EXPECT_EQ(result.level, 2);
+    EXPECT_DOUBLE_EQ(result.confidence, 0.5);
+}
+
+// 이어서 사용한 행은 각도는 그대로 두고 넘겨받은 프레임 나이와 버려진 프레임 수를 기록
+TEST_F(VVEstimatorTest, CarryForwardRecordsSkippedFrameTiming) {
+    std::vector<float> histogram(180, 0.0f);
+    histogram[90] = 1.0f;
+    vv::FrameTiming measuredTiming;
+    measuredTiming.ageMs = 12.0;
+    measuredTiming.droppedFrames = 1;
+    vv::VVResult measured = estimator->estimateVV(histogram, vv::VVResult(), 0, measuredTiming);
+
+    vv::FrameTiming skippedTiming;
+    skippedTiming.ageMs = 45.0;
+    skippedTiming.droppedFrames = 3;
+    vv::VVResult carried = estimator->carryForward(measured, skippedTiming);
+    EXPECT_FALSE(carried.measured);
+    EXPECT_DOUBLE_EQ(carried.angle, measured.angle);
+    EXPECT_DOUBLE_EQ(carried.frameAgeMs, 45.0);
+    EXPECT_EQ(carried.droppedFrames, 3);
+    EXPECT_EQ(estimator->getResults().size(), 2u);
+}
+
+// 바뀐 막대와 표시선만 다시 그린 시각화가 처음부터 그린 시각화와 같은지 테스트
+TEST_F(VVEstimatorTest, HistogramVisualizationRepaintsIncrementally) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> value(0.0f, 1.0f);
+    std::vector<float> histogram(180);
+    vv::VVResult result;
+    for (int frame = 0; frame < 4; frame++) {
+        for (size_t i = 0; i < histogram.size(); i++) {
+            // 일부 막대만 바뀌는 프레임도 포함
+            if (frame == 0 || i % (frame + 1) == 0) {
+                histogram[i] = value(rng);
+            }
+        }
+        result.angle = 40.0 + 30.0 * frame;
+        cv::Mat cached = estimator->createHistogramVisualization(histogram, result, 720, 200).clone();
+        vv::VVEstimator fresh;
+        cv::Mat expected = fresh.createHistogramVisualization(histogram, result, 720, 200);
+        EXPECT_EQ(cv::norm(cached, expected, cv::NORM_INF), 0.0) << "frame " << frame;
+    }
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();